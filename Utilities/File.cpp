@@ -1411,6 +1411,100 @@ fs::native_handle fs::file::get_handle() const
 #endif
 }
 
+fs::file_view::file_view(const file& f, u64 size)
+{
+	if (!f)
+	{
+		g_tls_error = fs::error::inval;
+		return;
+	}
+
+	size = std::min<u64>(size, f.size());
+
+	if (!size)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	const HANDLE map = CreateFileMappingW(f.get_handle(), nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!map)
+	{
+		g_tls_error = to_error(GetLastError());
+		return;
+	}
+
+	const auto ptr = MapViewOfFile(map, FILE_MAP_READ, 0, 0, static_cast<usz>(size));
+
+	if (!ptr)
+	{
+		g_tls_error = to_error(GetLastError());
+		CloseHandle(map);
+		return;
+	}
+
+	m_map = map;
+#else
+	const auto ptr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, f.get_handle(), 0);
+
+	if (ptr == MAP_FAILED)
+	{
+		g_tls_error = to_error(errno);
+		return;
+	}
+#endif
+
+	m_ptr = static_cast<const u8*>(ptr);
+	m_size = size;
+}
+
+fs::file_view::file_view(file_view&& other) noexcept
+	: m_ptr(std::exchange(other.m_ptr, nullptr))
+	, m_size(std::exchange(other.m_size, 0))
+#ifdef _WIN32
+	, m_map(std::exchange(other.m_map, nullptr))
+#endif
+{
+}
+
+fs::file_view& fs::file_view::operator=(file_view&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		m_ptr = std::exchange(other.m_ptr, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+#ifdef _WIN32
+		m_map = std::exchange(other.m_map, nullptr);
+#endif
+	}
+
+	return *this;
+}
+
+fs::file_view::~file_view()
+{
+	close();
+}
+
+void fs::file_view::close()
+{
+	if (m_ptr)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_ptr);
+		CloseHandle(m_map);
+		m_map = nullptr;
+#else
+		::munmap(const_cast<u8*>(m_ptr), m_size);
+#endif
+	}
+
+	m_ptr = nullptr;
+	m_size = 0;
+}
+
 bool fs::dir::open(const std::string& path)
 {
 	if (path.empty())
@@ -499,6 +499,52 @@ namespace fs
 		}
 	};
 
+	// Read-only memory mapping of the file contents
+	class file_view final
+	{
+		const u8* m_ptr{};
+		u64 m_size{};
+
+#ifdef _WIN32
+		void* m_map{};
+#endif
+
+	public:
+		file_view() = default;
+
+		// Map first `size` bytes of the file (whole file if -1)
+		explicit file_view(const file& f, u64 size = -1);
+
+		file_view(const file_view&) = delete;
+
+		file_view& operator=(const file_view&) = delete;
+
+		file_view(file_view&& other) noexcept;
+
+		file_view& operator=(file_view&& other) noexcept;
+
+		~file_view();
+
+		// Check whether the mapping is valid (empty files are never mapped)
+		explicit operator bool() const
+		{
+			return m_ptr != nullptr;
+		}
+
+		// Unmap explicitly
+		void close();
+
+		const u8* data() const
+		{
+			return m_ptr;
+		}
+
+		u64 size() const
+		{
+			return m_size;
+		}
+	};
+
 	class dir final
 	{
 		std::unique_ptr<dir_base> m_dir{};
@@ -273,6 +273,7 @@ asmjit::Runtime& asmjit::get_global_runtime()
 #include <unordered_map>
 #include <unordered_set>
 #include <deque>
+#include <chrono>
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -516,14 +517,38 @@ struct MemoryManager2 : llvm::RTDyldMemoryManager
 	}
 };
 
+// Memory buffer over a mapped object file
+class MappedBuffer final : public llvm::MemoryBuffer
+{
+	fs::file_view m_view;
+
+public:
+	MappedBuffer(fs::file_view&& view)
+		: m_view(std::move(view))
+	{
+		const auto ptr = reinterpret_cast<const char*>(m_view.data());
+		init(ptr, ptr + m_view.size(), false);
+	}
+
+	~MappedBuffer() override = default;
+
+	BufferKind getBufferKind() const override
+	{
+		return MemoryBuffer_MMap;
+	}
+};
+
 // Helper class
 class ObjectCache final : public llvm::ObjectCache
 {
 	const std::string& m_path;
 
+	const int m_level;
+
 public:
-	ObjectCache(const std::string& path)
+	ObjectCache(const std::string& path, int level)
 		: m_path(path)
+		, m_level(level)
 	{
 	}
 
@@ -533,7 +558,24 @@ public:
 	{
 		std::string name = m_path;
 		name.append(_module->getName().data());
-		//fs::file(name, fs::rewrite).write(obj.getBufferStart(), obj.getBufferSize());
+
+		if (m_level == 0)
+		{
+			// Store as is, remove the compressed version (loaded second)
+			fs::remove_file(name + ".gz");
+
+			if (!fs::write_file(name, fs::rewrite, obj.getBufferStart(), obj.getBufferSize()))
+			{
+				jit_log.error("LLVM: Failed to create module file: %s (%s)", name, fs::g_tls_error);
+				return;
+			}
+
+			jit_log.notice("LLVM: Created module: %s", _module->getName().data());
+			return;
+		}
+
+		// Remove the uncompressed version (loaded first)
+		fs::remove_file(name);
 		name.append(".gz");
 
 		z_stream zs{};
@@ -543,7 +585,7 @@ public:
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 #endif
-		deflateInit2(&zs, 9, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY);
+		deflateInit2(&zs, m_level, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY);
 #ifndef _MSC_VER
 #pragma GCC diagnostic pop
 #endif
@@ -577,8 +619,31 @@ public:
 		jit_log.notice("LLVM: Created module: %s", _module->getName().data());
 	}
 
-	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path)
+	static std::unique_ptr<llvm::MemoryBuffer> load(const std::string& path, bool* compressed = nullptr)
 	{
+		if (fs::file cached{path, fs::read})
+		{
+			if (cached.size() == 0) [[unlikely]]
+			{
+				return nullptr;
+			}
+
+			if (compressed)
+			{
+				*compressed = false;
+			}
+
+			// Map uncompressed object directly
+			if (fs::file_view view{cached}; view && view.size() == cached.size())
+			{
+				return std::make_unique<MappedBuffer>(std::move(view));
+			}
+
+			auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(cached.size());
+			cached.read(buf->getBufferStart(), buf->getBufferSize());
+			return buf;
+		}
+
 		if (fs::file cached{path + ".gz", fs::read})
 		{
 			std::vector<uchar> gz = cached.to_vector<uchar>();
@@ -589,6 +654,11 @@ public:
 			{
 				return nullptr;
 			}
+
+			if (compressed)
+			{
+				*compressed = true;
+			}
 #ifndef _MSC_VER
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
@@ -637,18 +707,6 @@ public:
 			return buf;
 		}
 
-		if (fs::file cached{path, fs::read})
-		{
-			if (cached.size() == 0) [[unlikely]]
-			{
-				return nullptr;
-			}
-
-			auto buf = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(cached.size());
-			cached.read(buf->getBufferStart(), buf->getBufferSize());
-			return buf;
-		}
-
 		return nullptr;
 	}
 
@@ -724,6 +782,7 @@ std::string jit_compiler::cpu(const std::string& _cpu)
 
 jit_compiler::jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags)
 	: m_cpu(cpu(_cpu))
+	, m_cache_level(flags & 0x8 ? 0 : flags & 0x4 ? 1 : 9)
 {
 	std::string result;
 
@@ -783,7 +842,7 @@ jit_compiler::~jit_compiler()
 
 void jit_compiler::add(std::unique_ptr<llvm::Module> _module, const std::string& path)
 {
-	ObjectCache cache{path};
+	ObjectCache cache{path, m_cache_level};
 	m_engine->setObjectCache(&cache);
 
 	const auto ptr = _module.get();
@@ -813,7 +872,18 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 
 void jit_compiler::add(const std::string& path)
 {
-	auto cache = ObjectCache::load(path);
+	const auto start = std::chrono::steady_clock::now();
+
+	bool compressed = false;
+	auto cache = ObjectCache::load(path, &compressed);
+
+	if (!cache)
+	{
+		jit_log.error("ObjectCache: Loading failed: %s", path);
+		return;
+	}
+
+	jit_log.notice("ObjectCache: Loaded %s object in %uus: %s", compressed ? "compressed" : "uncompressed", std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count(), path);
 
 	if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
 	{
@@ -834,9 +904,26 @@ bool jit_compiler::check(const std::string& path)
 			return true;
 		}
 
-		if (fs::remove_file(path))
+		for (const char* ext : {"", ".gz"})
+		{
+			if (fs::remove_file(path + ext))
+			{
+				jit_log.error("ObjectCache: Removed damaged file: %s%s", path, ext);
+			}
+		}
+	}
+
+	return false;
+}
+
+bool jit_compiler::copy(const std::string& from, const std::string& to)
+{
+	// Same lookup order as ObjectCache::load
+	for (const char* ext : {"", ".gz"})
+	{
+		if (fs::is_file(from + ext))
 		{
-			jit_log.error("ObjectCache: Removed damaged file: %s", path);
+			return fs::copy_file(from + ext, to + ext, true);
 		}
 	}
 
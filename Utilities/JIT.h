@@ -214,7 +214,11 @@ class jit_compiler final
 	// Arch
 	std::string m_cpu{};
 
+	// Object cache zlib level (0: stored uncompressed)
+	int m_cache_level = 9;
+
 public:
+	// Flags: 0x1 (custom memory manager), 0x2 (large code model), 0x4 (fast cache compression), 0x8 (uncompressed cache)
 	jit_compiler(const std::unordered_map<std::string, u64>& _link, const std::string& _cpu, u32 flags = 0);
 	~jit_compiler();
 
@@ -241,6 +245,9 @@ public:
 	// Check object file
 	static bool check(const std::string& path);
 
+	// Copy cached object file (path to obj file)
+	static bool copy(const std::string& from, const std::string& to);
+
 	// Finalize
 	void fin();
 
@@ -35,6 +35,13 @@
 #include <intrin.h>
 #endif
 
+#if defined(_MSC_VER)
+#define AESNI_FUNC
+#else
+#include <immintrin.h>
+#define AESNI_FUNC __attribute__((__target__("aes,ssse3")))
+#endif
+
 /*
  * AES-NI support detection routine
  */
@@ -129,6 +136,59 @@ int aesni_crypt_ecb( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-NI AES-CTR keystream XOR (128-bit big-endian counter), 8 blocks in flight
+ */
+AESNI_FUNC void aesni_crypt_ctr_xor( aes_context *ctx,
+                                     const unsigned char counter[16],
+                                     size_t blocks,
+                                     unsigned char *data )
+{
+    const __m128i* rk = (const __m128i*) ctx->rk;
+    const __m128i bswap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+    unsigned long long hi = 0, lo = 0;
+    __m128i x[8];
+    size_t b, j;
+    int i;
+
+    for( i = 0; i < 8; i++ )
+    {
+        hi = hi << 8 | counter[i];
+        lo = lo << 8 | counter[i + 8];
+    }
+
+    for( b = 0; b < blocks; b += 8 )
+    {
+        const size_t count = blocks - b < 8 ? blocks - b : 8;
+
+        // Round 0 for 8 consecutive counter values
+        for( j = 0; j < 8; j++ )
+        {
+            x[j] = _mm_xor_si128( _mm_shuffle_epi8( _mm_set_epi64x( (long long) hi, (long long) lo ), bswap ), _mm_loadu_si128( rk ) );
+
+            if( ++lo == 0 )
+                hi++;
+        }
+
+        // Independent blocks hide the latency of aesenc
+        for( i = 1; i < ctx->nr; i++ )
+        {
+            const __m128i k = _mm_loadu_si128( rk + i );
+
+            for( j = 0; j < 8; j++ )
+                x[j] = _mm_aesenc_si128( x[j], k );
+        }
+
+        for( j = 0; j < count; j++ )
+        {
+            __m128i* p = (__m128i*) ( data + ( b + j ) * 16 );
+
+            x[j] = _mm_aesenclast_si128( x[j], _mm_loadu_si128( rk + ctx->nr ) );
+            _mm_storeu_si128( p, _mm_xor_si128( _mm_loadu_si128( p ), x[j] ) );
+        }
+    }
+}
+
 #if defined(POLARSSL_HAVE_MSVC_X64_INTRINSICS)
 static inline void clmul256( __m128i a, __m128i b, __m128i* r0, __m128i* r1 )
 {
@@ -61,6 +61,19 @@ int aesni_crypt_ecb( aes_context *ctx,
                      const unsigned char input[16],
                      unsigned char output[16] );
 
+/**
+ * \brief          AES-NI AES-CTR keystream XOR, processing 8 blocks at a time
+ *
+ * \param ctx      AES context (encryption round keys)
+ * \param counter  16-byte big-endian counter of the first block
+ * \param blocks   Number of 16-byte blocks
+ * \param data     Data to XOR with the keystream (in place)
+ */
+void aesni_crypt_ctr_xor( aes_context *ctx,
+                          const unsigned char counter[16],
+                          size_t blocks,
+                          unsigned char *data );
+
 /**
  * \brief          GCM multiplication: c = a * b in GF(2^128)
  *
@@ -961,40 +961,79 @@ bool EDATADecrypter::ReadHeader()
 	return true;
 }
 
-u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
+const EDATADecrypter::cached_block* EDATADecrypter::GetBlock(u32 block_num)
 {
-	if (pos > edatHeader.file_size)
-		return 0;
+	cached_block* lru = &block_cache[0];
 
-	// now we need to offset things to account for the actual 'range' requested
-	const u64 startOffset = pos % edatHeader.block_size;
+	for (auto& block : block_cache)
+	{
+		if (block.block_num == block_num)
+		{
+			block.last_use = ++block_cache_tick;
+			return &block;
+		}
+
+		if (block.last_use < lru->last_use)
+		{
+			lru = &block;
+		}
+	}
 
-	const u32 num_blocks = static_cast<u32>(utils::aligned_div(startOffset + size, edatHeader.block_size));
-	const u64 bufSize = num_blocks*edatHeader.block_size;
-	if (data_buf_size < (bufSize))
+	if (!lru->data)
 	{
-		data_buf.reset(new u8[bufSize]);
-		data_buf_size = bufSize;
+		// Decompression writes up to block_size bytes, decryption up to the padded length
+		lru->data.reset(new u8[utils::align<u64>(edatHeader.block_size, 0x10)]);
 	}
 
-	// find and decrypt block range covering pos + size
-	const u32 starting_block = static_cast<u32>(pos / edatHeader.block_size);
-	const u32 ending_block = std::min(starting_block + num_blocks, total_blocks);
-	u64 writeOffset = 0;
-	for (u32 i = starting_block; i < ending_block; ++i)
+	// Invalidate until decrypted
+	lru->block_num = -1;
+	lru->last_use = 0;
+
+	edata_file.seek(0);
+	const s64 res = decrypt_block(&edata_file, lru->data.get(), &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), block_num, total_blocks, edatHeader.file_size);
+
+	if (res < 0)
 	{
-		edata_file.seek(0);
-		u64 res = decrypt_block(&edata_file, &data_buf[writeOffset], &edatHeader, &npdHeader, reinterpret_cast<uchar*>(&dec_key), i, total_blocks, edatHeader.file_size);
-		if (res == umax)
+		edat_log.error("Error Decrypting data (block %u)", block_num);
+		return nullptr;
+	}
+
+	lru->block_num = block_num;
+	lru->size = static_cast<u32>(res);
+	lru->last_use = ++block_cache_tick;
+	return lru;
+}
+
+u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
+{
+	if (pos >= edatHeader.file_size)
+		return 0;
+
+	size = std::min<u64>(size, edatHeader.file_size - pos);
+
+	// Only decrypt the blocks covering the requested range, one at a time
+	u64 bytes_read = 0;
+
+	for (u32 i = static_cast<u32>(pos / edatHeader.block_size); bytes_read < size && i < total_blocks; i++)
+	{
+		const cached_block* block = GetBlock(i);
+
+		if (!block)
 		{
-			edat_log.error("Error Decrypting data");
-			return 0;
+			break;
+		}
+
+		const u64 offset = pos + bytes_read - u64{i} * edatHeader.block_size;
+
+		if (offset >= block->size)
+		{
+			break;
 		}
-		writeOffset += res;
-	}
 
-	const u64 bytesWrote = std::min<u64>(writeOffset - startOffset, size);
+		const u64 count = std::min<u64>(block->size - offset, size - bytes_read);
+		std::memcpy(data + bytes_read, block->data.get() + offset, count);
+		bytes_read += count;
+	}
 
-	memcpy(data, &data_buf[startOffset], bytesWrote);
-	return bytesWrote;
+	return bytes_read;
 }
@@ -60,9 +60,19 @@ struct EDATADecrypter final : fs::file_base
 	NPD_HEADER npdHeader{};
 	EDAT_HEADER edatHeader{};
 
-	// Internal data buffers.
-	std::unique_ptr<u8[]> data_buf{};
-	u64 data_buf_size{0};
+	// Decrypted block cache (LRU), keeps sequential small reads from decrypting the same block again
+	static constexpr u32 block_cache_count = 4;
+
+	struct cached_block
+	{
+		u32 block_num = -1;
+		u32 size = 0;
+		u64 last_use = 0;
+		std::unique_ptr<u8[]> data{};
+	};
+
+	std::array<cached_block, block_cache_count> block_cache{};
+	u64 block_cache_tick{0};
 
 	u128 dec_key{};
 
@@ -84,6 +94,12 @@ public:
 	bool ReadHeader();
 	u64 ReadData(u64 pos, u8* data, u64 size);
 
+private:
+	// Get decrypted block data from the cache or decrypt it, nullptr on error
+	const cached_block* GetBlock(u32 block_num);
+
+public:
+
 	fs::stat_t stat() override
 	{
 		fs::stat_t stats;
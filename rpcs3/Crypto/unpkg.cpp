@@ -1,16 +1,23 @@
 #include "stdafx.h"
 #include "aes.h"
+#include "aesni.h"
 #include "sha1.h"
 #include "key_vault.h"
 #include "util/logs.hpp"
+#include "util/sysinfo.hpp"
 #include "Utilities/StrUtil.h"
+#include "Utilities/Thread.h"
 #include "Emu/System.h"
 #include "Emu/VFS.h"
 #include "unpkg.h"
 #include "Loader/PSF.h"
 
+#include <deque>
+
 LOG_CHANNEL(pkg_log, "PKG");
 
+static const bool s_use_aesni = aesni_supports(POLARSSL_AESNI_AES);
+
 package_reader::package_reader(const std::string& path)
 	: m_path(path)
 {
@@ -725,6 +732,27 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 
 	std::memcpy(entries.data(), m_buf.get(), entries.size() * sizeof(PKGEntry));
 
+	// Files to extract, the data is processed in chunks by the pipeline below
+	struct file_job
+	{
+		std::string path;
+		u64 file_offset;
+		u64 file_size;
+		bool is_psp;
+		bool did_overwrite;
+		atomic_t<bool> failed{};
+	};
+
+	struct chunk_job
+	{
+		file_job* file;
+		u64 pos;
+		u64 size;
+	};
+
+	std::deque<file_job> files;
+	std::vector<chunk_job> chunks;
+
 	for (const auto& entry : entries)
 	{
 		if (entry.name_size > 256)
@@ -769,62 +797,24 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 				break;
 			}
 
-			if (fs::file out{ path, fs::rewrite })
-			{
-				bool extract_success = true;
-				for (u64 pos = 0; pos < entry.file_size; pos += BUF_SIZE)
-				{
-					const u64 block_size = std::min<u64>(BUF_SIZE, entry.file_size - pos);
-
-					if (decrypt(entry.file_offset + pos, block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data()) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to extract file %s", path);
-						break;
-					}
-
-					if (out.write(m_buf.get(), block_size) != block_size)
-					{
-						extract_success = false;
-						pkg_log.error("Failed to write file %s", path);
-						break;
-					}
-
-					if (sync.fetch_add((block_size + 0.0) / m_header.data_size) < 0.)
-					{
-						if (was_null)
-						{
-							pkg_log.error("Package installation cancelled: %s", dir);
-							out.close();
-							fs::remove_all(dir, true);
-							return false;
-						}
-
-						// Cannot cancel the installation
-						sync += 1.;
-					}
-				}
-
-				if (extract_success)
-				{
-					if (did_overwrite)
-					{
-						pkg_log.warning("Overwritten file %s", path);
-					}
-					else
-					{
-						pkg_log.notice("Created file %s", path);
-					}
-				}
-				else
-				{
-					num_failures++;
-				}
-			}
-			else
+			// Create the file now (in entry order), the data is written by the workers
+			if (fs::file out{ path, fs::rewrite }; !out || !out.trunc(entry.file_size))
 			{
 				num_failures++;
 				pkg_log.error("Failed to create file %s", path);
+				break;
+			}
+
+			auto& file = files.emplace_back();
+			file.path = path;
+			file.file_offset = entry.file_offset;
+			file.file_size = entry.file_size;
+			file.is_psp = is_psp;
+			file.did_overwrite = did_overwrite;
+
+			for (u64 pos = 0; pos < entry.file_size; pos += CHUNK_SIZE)
+			{
+				chunks.push_back(chunk_job{&file, pos, std::min<u64>(CHUNK_SIZE, entry.file_size - pos)});
 			}
 
 			break;
@@ -858,6 +848,152 @@ bool package_reader::extract_data(atomic_t<double>& sync)
 		}
 	}
 
+	// Pipeline: this thread reads the archive sequentially into a ring of buffers,
+	// workers decrypt the chunks and write them at their offsets in the output files.
+	// Slot state for chunk c: 2 * (c / slot_count) when free, + 1 when the data is read.
+	const u32 worker_count = std::clamp<u32>(utils::get_thread_count() / 2, 1, 8);
+	const usz slot_count = worker_count * 2;
+
+	std::vector<std::unique_ptr<u128[]>> slot_data(slot_count);
+	std::unique_ptr<atomic_t<u64>[]> slot_state(new atomic_t<u64>[slot_count]{});
+
+	atomic_t<usz> next_chunk = 0;
+	atomic_t<bool> abort = false;
+	atomic_t<bool> failed = false;
+	atomic_t<bool> cancelled = false;
+	atomic_t<bool> uncancellable = false;
+
+	const auto start_time = steady_clock::now();
+
+	named_thread_group workers("PKG Worker ", worker_count, [&]()
+	{
+		for (usz c = next_chunk++; c < chunks.size(); c = next_chunk++)
+		{
+			auto& state = slot_state[c % slot_count];
+			const u64 ready = c / slot_count * 2 + 1;
+
+			for (u64 v; (v = state) != ready;)
+			{
+				if (abort)
+				{
+					return;
+				}
+
+				state.wait(v);
+			}
+
+			const chunk_job& chunk = chunks[c];
+			u128* const buf = slot_data[c % slot_count].get();
+
+			decrypt_buffer(chunk.file->file_offset + chunk.pos, chunk.size, chunk.file->is_psp ? PKG_AES_KEY2 : m_dec_key.data(), buf);
+
+			if (fs::file out{chunk.file->path, fs::write}; !out || out.seek(chunk.pos) != chunk.pos || out.write(buf, chunk.size) != chunk.size)
+			{
+				pkg_log.error("Failed to write file %s", chunk.file->path);
+				chunk.file->failed = true;
+				failed = true;
+			}
+
+			// Release the slot for the next read
+			state = ready + 1;
+			state.notify_all();
+
+			if (sync.fetch_add((chunk.size + 0.0) / m_header.data_size) < 0.)
+			{
+				if (was_null)
+				{
+					cancelled = true;
+				}
+				else if (!uncancellable.exchange(true))
+				{
+					// Cannot cancel the installation
+					sync += 1.;
+				}
+			}
+		}
+	});
+
+	for (usz c = 0; c < chunks.size(); c++)
+	{
+		auto& state = slot_state[c % slot_count];
+		const u64 free = c / slot_count * 2;
+
+		for (u64 v; (v = state) != free && !failed && !cancelled;)
+		{
+			state.wait(v);
+		}
+
+		if (failed || cancelled)
+		{
+			break;
+		}
+
+		auto& buf = slot_data[c % slot_count];
+
+		if (!buf)
+		{
+			buf.reset(new u128[CHUNK_SIZE / sizeof(u128)]);
+		}
+
+		const chunk_job& chunk = chunks[c];
+
+		archive_seek(m_header.data_offset + chunk.file->file_offset + chunk.pos);
+
+		if (archive_read(buf.get(), chunk.size) != chunk.size)
+		{
+			pkg_log.error("Failed to extract file %s", chunk.file->path);
+			chunk.file->failed = true;
+			failed = true;
+			break;
+		}
+
+		state = free + 1;
+		state.notify_all();
+	}
+
+	if (failed || cancelled)
+	{
+		// Wake up the workers waiting for data which will never be read
+		abort = true;
+
+		for (usz i = 0; i < slot_count; i++)
+		{
+			slot_state[i] = -1;
+			slot_state[i].notify_all();
+		}
+	}
+
+	// Join the workers
+	workers.join();
+
+	if (cancelled)
+	{
+		pkg_log.error("Package installation cancelled: %s", dir);
+		fs::remove_all(dir, true);
+		return false;
+	}
+
+	for (const file_job& file : files)
+	{
+		if (file.failed)
+		{
+			num_failures++;
+		}
+		else if (file.did_overwrite)
+		{
+			pkg_log.warning("Overwritten file %s", file.path);
+		}
+		else
+		{
+			pkg_log.notice("Created file %s", file.path);
+		}
+	}
+
+	if (const u64 usec = std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - start_time).count())
+	{
+		pkg_log.notice("Extracted %u files (%.2f MB) in %.3fs, %.1f MB/s (%u workers)", files.size(), m_header.data_size / 1048576., usec / 1e6, m_header.data_size * 1e6 / 1048576. / usec, worker_count);
+	}
+
 	if (num_failures == 0)
 	{
 		pkg_log.success("Package successfully installed to %s", dir);
@@ -945,8 +1081,16 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 	// Read the data and set available size
 	const u64 read = archive_read(m_buf.get(), size);
 
+	decrypt_buffer(offset, read, key, m_buf.get());
+
+	// Return the amount of data written in buf
+	return read;
+};
+
+void package_reader::decrypt_buffer(u64 offset, u64 size, const uchar* key, u128* buf) const
+{
 	// Get block count
-	const u64 blocks = (read + 15) / 16;
+	const u64 blocks = (size + 15) / 16;
 
 	if (m_header.pkg_type == PKG_RELEASE_TYPE_DEBUG)
 	{
@@ -972,7 +1116,7 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 			sha1(reinterpret_cast<const u8*>(input), sizeof(input), hash.data);
 
-			m_buf[i] ^= hash._v128;
+			buf[i] ^= hash._v128;
 		}
 	}
 	else if (m_header.pkg_type == PKG_RELEASE_TYPE_RELEASE)
@@ -985,6 +1129,13 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 		// Initialize stream cipher for start position
 		be_t<u128> input = m_header.klicensee.value() + offset / 16;
 
+		if (s_use_aesni)
+		{
+			// Generate the keystream 8 blocks at a time
+			aesni_crypt_ctr_xor(&ctx, reinterpret_cast<const u8*>(&input), blocks, reinterpret_cast<u8*>(buf));
+			return;
+		}
+
 		// Increment stream position for every block
 		for (u64 i = 0; i < blocks; i++, input++)
 		{
@@ -992,14 +1143,11 @@ u64 package_reader::decrypt(u64 offset, u64 size, const uchar* key)
 
 			aes_crypt_ecb(&ctx, AES_ENCRYPT, reinterpret_cast<const u8*>(&input), reinterpret_cast<u8*>(&key));
 
-			m_buf[i] ^= key;
+			buf[i] ^= key;
 		}
 	}
 	else
 	{
 		pkg_log.error("Unknown release type (0x%x)", m_header.pkg_type);
 	}
-
-	// Return the amount of data written in buf
-	return read;
-};
+}
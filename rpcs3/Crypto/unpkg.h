@@ -318,8 +318,10 @@ private:
 	void archive_seek(const s64 new_offset, const fs::seek_mode damode = fs::seek_set);
 	u64 archive_read(void* data_ptr, const u64 num_bytes);
 	u64 decrypt(u64 offset, u64 size, const uchar* key);
+	void decrypt_buffer(u64 offset, u64 size, const uchar* key, u128* buf) const;
 
 	const usz BUF_SIZE = 8192 * 1024; // 8 MB
+	const usz CHUNK_SIZE = 1024 * 1024; // 1 MB, unit of work for extraction workers
 
 	bool m_is_valid = false;
 
@@ -71,6 +71,9 @@ struct cpu_prof
 	// PPU/SPU id enqueued for registration
 	lf_queue<u32> registered;
 
+	// PPU sample taken inside of an HLE function (pointer to its name)
+	static constexpr u64 hle_flag = 1ull << 63;
+
 	struct sample_info
 	{
 		// Weak pointer to the thread
@@ -82,8 +85,14 @@ struct cpu_prof
 		// Total number of samples
 		u64 samples = 0, idle = 0;
 
+		// Thread name and type for the exported stacks
+		std::string thread_name;
+		bool is_ppu = false;
+
 		sample_info(const std::shared_ptr<cpu_thread>& ptr)
 			: wptr(ptr)
+			, thread_name(ptr->get_name())
+			, is_ppu(ptr->id_type() == 1)
 		{
 		}
 
@@ -94,6 +103,34 @@ struct cpu_prof
 			idle = 0;
 		}
 
+		// Get block name (SPU: short program hash and chunk address, PPU: address or HLE function)
+		std::string get_block_name(u64 name, bool short_name) const
+		{
+			std::string result;
+
+			if (is_ppu)
+			{
+				if (name & hle_flag)
+					result = reinterpret_cast<const char*>(name & ~hle_flag);
+				else
+					fmt::append(result, "0x%08x", name);
+
+				return result;
+			}
+
+			// Print only 7 hash characters out of 11 (which covers roughly 48 bits)
+			result = fmt::format("%s", fmt::base57(be_t<u64>{name}));
+			result.resize(result.size() - 4);
+
+			if (!short_name)
+			{
+				// Print chunk address from lowest 16 bits
+				fmt::append(result, "...chunk-0x%05x", (name & 0xffff) * 4);
+			}
+
+			return result;
+		}
+
 		// Print info
 		void print(u32 id) const
 		{
@@ -116,12 +153,7 @@ struct cpu_prof
 			{
 				const f64 _frac = count / busy / samples;
 
-				// Print only 7 hash characters out of 11 (which covers roughly 48 bits)
-				fmt::append(results, "\n\t[%s", fmt::base57(be_t<u64>{name}));
-				results.resize(results.size() - 4);
-
-				// Print chunk address from lowest 16 bits
-				fmt::append(results, "...chunk-0x%05x]: %.4f%% (%u)", (name & 0xffff) * 4, _frac * 100., count);
+				fmt::append(results, "\n\t[%s]: %.4f%% (%u)", get_block_name(name, false), _frac * 100., count);
 
 				if (results.size() >= 5000)
 				{
@@ -132,12 +164,59 @@ struct cpu_prof
 
 			profiler.notice("Thread [0x%08x]: %u samples (%.4f%% idle):%s", id, samples, 100. * idle / samples, results);
 		}
+
+		// Accumulate non-idle samples as collapsed stacks (SPU programs are merged across threads)
+		void collapse(std::map<std::string, u64>& stacks) const
+		{
+			for (auto& [name, count] : freq)
+			{
+				if (is_ppu)
+				{
+					stacks[fmt::format("PPU;%s;%s", thread_name, get_block_name(name, false))] += count;
+				}
+				else
+				{
+					stacks[fmt::format("SPU;%s;chunk-0x%05x", get_block_name(name, true), (name & 0xffff) * 4)] += count;
+				}
+			}
+		}
 	};
 
+	// Write collapsed stacks (flamegraph.pl and speedscope input format)
+	static void save(const std::map<std::string, u64>& stacks)
+	{
+		if (stacks.empty())
+		{
+			return;
+		}
+
+		const std::string dir = fs::get_cache_dir() + "profiler/";
+		const std::string title_id = Emu.GetTitleID();
+		const std::string path = dir + (title_id.empty() ? "unknown"s : title_id) + ".folded";
+
+		std::string data;
+
+		for (auto& [stack, count] : stacks)
+		{
+			fmt::append(data, "%s %u\n", stack, count);
+		}
+
+		if (!fs::create_path(dir) || !fs::write_file(path, fs::rewrite, data))
+		{
+			profiler.error("Failed to write profiling results to %s (%s)", path, fs::g_tls_error);
+			return;
+		}
+
+		profiler.success("Collapsed stacks saved to %s", path);
+	}
+
 	void operator()()
 	{
 		std::unordered_map<u32, sample_info, value_hash<u64>> threads;
 
+		// Samples of all threads since the start
+		std::map<std::string, u64> stacks;
+
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
 			bool flush = false;
@@ -176,13 +255,15 @@ struct cpu_prof
 					{
 						// Overwritten: print previous data
 						found->second.print(id);
+						found->second.collapse(stacks);
 						found->second.reset();
 						found->second.wptr = ptr;
+						found->second.thread_name = ptr->get_name();
 					}
 				}
 			}
 
-			if (threads.empty())
+			if (threads.empty() && !flush)
 			{
 				// Wait for messages if no work (don't waste CPU)
 				thread_ctrl::wait_on(registered, nullptr);
@@ -194,8 +275,23 @@ struct cpu_prof
 			{
 				if (auto ptr = info.wptr.lock())
 				{
-					// Get short function hash
-					const u64 name = atomic_storage<u64>::load(ptr->block_hash);
+					u64 name;
+
+					if (info.is_ppu)
+					{
+						// Current HLE function if any, otherwise the last address stored (updated on calls and syscalls by LLVM)
+						const auto& ppu = static_cast<const ppu_thread&>(*ptr);
+
+						if (const char* func = atomic_storage<const char*>::load(ppu.current_function))
+							name = reinterpret_cast<u64>(func) | hle_flag;
+						else
+							name = atomic_storage<u32>::load(ppu.cia);
+					}
+					else
+					{
+						// Get short function hash
+						name = atomic_storage<u64>::load(ptr->block_hash);
+					}
 
 					// Append occurrence
 					info.samples++;
@@ -205,7 +301,7 @@ struct cpu_prof
 						info.freq[name]++;
 
 						// Append verification time to fixed common name 0000000...chunk-0x3fffc
-						if ((name & 0xffff) == 0)
+						if (!info.is_ppu && (name & 0xffff) == 0)
 							info.freq[0xffff]++;
 					}
 					else
@@ -219,7 +315,7 @@ struct cpu_prof
 			for (auto it = threads.begin(), end = threads.end(); it != end;)
 			{
 				if (it->second.wptr.expired())
-					it->second.print(it->first), it = threads.erase(it);
+					it->second.print(it->first), it->second.collapse(stacks), it = threads.erase(it);
 				else
 					it++;
 			}
@@ -232,8 +328,11 @@ struct cpu_prof
 				for (auto& [id, info] : threads)
 				{
 					info.print(id);
+					info.collapse(stacks);
 					info.reset();
 				}
+
+				save(stacks);
 			}
 
 			// Wait, roughly for 20µs
@@ -244,7 +343,10 @@ struct cpu_prof
 		for (auto& [id, info] : threads)
 		{
 			info.print(id);
+			info.collapse(stacks);
 		}
+
+		save(stacks);
 	}
 
 	static constexpr auto thread_name = "CPU Profiler"sv;
@@ -444,7 +546,11 @@ void cpu_thread::operator()()
 	{
 	case 1:
 	{
-		//g_fxo->get<cpu_profiler>().registered.push(id);
+		if (g_cfg.core.ppu_prof)
+		{
+			g_fxo->get<cpu_profiler>().registered.push(id);
+		}
+
 		break;
 	}
 	case 2:
@@ -1179,7 +1285,7 @@ void cpu_thread::flush_profilers() noexcept
 		return;
 	}
 
-	if (g_cfg.core.spu_prof)
+	if (g_cfg.core.spu_prof || g_cfg.core.ppu_prof)
 	{
 		g_fxo->get<cpu_profiler>().registered.push(0);
 	}
@@ -5,6 +5,8 @@
 
 #include <vector>
 
+class lv2_sleep_queue;
+
 // Thread state flags
 enum class cpu_flag : u32
 {
@@ -58,6 +60,17 @@ public:
 	// Public thread state
 	atomic_bs_t<cpu_flag> state{cpu_flag::stop + cpu_flag::wait};
 
+	// Intrusive links of the lv2 sleep queue the thread is waiting in (lv2_sleep_queue, protected by the object mutex)
+	struct
+	{
+		lv2_sleep_queue* owner;
+		cpu_thread* next;
+		cpu_thread* prev;
+		cpu_thread* prio_next;
+		cpu_thread* prio_prev;
+		s32 prio;
+	} sleep_node{};
+
 	// Process thread state, return true if the checker must return
 	bool check_state() noexcept;
 
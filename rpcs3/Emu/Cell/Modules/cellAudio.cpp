@@ -6,9 +6,18 @@
 #include "Emu/Cell/lv2/sys_event.h"
 #include "cellAudio.h"
 
+#include "util/sysinfo.hpp"
+
 #include "emmintrin.h"
+#include "immintrin.h"
 #include <cmath>
 
+#if defined(_MSC_VER)
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif
+
 LOG_CHANNEL(cellAudio);
 
 vm::gvar<char, AUDIO_PORT_OFFSET * AUDIO_PORT_COUNT> g_audio_buffer;
@@ -872,6 +881,148 @@ void cell_audio_thread::operator()()
 	ringbuffer.reset();
 }
 
+static const bool s_use_avx2 = utils::has_avx2();
+
+// Load 4 big-endian floats
+static inline __m128 audio_load_be(const be_t<f32>* src)
+{
+	__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	v = _mm_or_si128(_mm_slli_epi32(v, 16), _mm_srli_epi32(v, 16));
+	v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+	return _mm_castsi128_ps(v);
+}
+
+// Store (or accumulate) 4 floats
+template <bool First>
+static inline void audio_store(float* dst, __m128 v)
+{
+	if constexpr (!First)
+	{
+		v = _mm_add_ps(v, _mm_loadu_ps(dst));
+	}
+
+	_mm_storeu_ps(dst, v);
+}
+
+// Store (or accumulate) 2 floats from the low half
+template <bool First>
+static inline void audio_store_lo(float* dst, __m128 v)
+{
+	if constexpr (!First)
+	{
+		v = _mm_add_ps(v, _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const f64*>(dst))));
+	}
+
+	_mm_storel_pi(reinterpret_cast<__m64*>(dst), v);
+}
+
+// Swap, scale and store (or accumulate) the samples of a port which matches the output layout
+template <bool First>
+AVX2_FUNC static void audio_mix_direct_avx2(float* out_buffer, const be_t<f32>* buf, f32 m, u32 count)
+{
+	const __m256 vol = _mm256_set1_ps(m);
+	const __m256i swap = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+
+	for (u32 i = 0; i < count; i += 8)
+	{
+		const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf + i));
+		__m256 v = _mm256_mul_ps(_mm256_castsi256_ps(_mm256_shuffle_epi8(in, swap)), vol);
+
+		if constexpr (!First)
+		{
+			v = _mm256_add_ps(v, _mm256_loadu_ps(out_buffer + i));
+		}
+
+		_mm256_storeu_ps(out_buffer + i, v);
+	}
+}
+
+// Mix a port with constant volume into the output buffer
+template <audio_downmix downmix, u32 InChannels, bool First>
+static void audio_mix_port(float* out_buffer, const be_t<f32>* buf, f32 m)
+{
+	constexpr u32 channels = downmix == audio_downmix::no_downmix ? 8 : downmix == audio_downmix::downmix_to_5_1 ? 6 : 2;
+	constexpr u32 out_buffer_sz = channels * AUDIO_BUFFER_SAMPLES;
+
+	const __m128 vol = _mm_set1_ps(m);
+	const __m128 zero = _mm_setzero_ps();
+
+	if constexpr (InChannels == channels)
+	{
+		if (s_use_avx2)
+		{
+			audio_mix_direct_avx2<First>(out_buffer, buf, m, out_buffer_sz);
+			return;
+		}
+
+		for (u32 i = 0; i < out_buffer_sz; i += 4)
+		{
+			audio_store<First>(out_buffer + i, _mm_mul_ps(audio_load_be(buf + i), vol));
+		}
+	}
+	else if constexpr (InChannels == 2)
+	{
+		// Stereo port into the front channels, two frames per iteration
+		for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels * 2, in += 4)
+		{
+			const __m128 v = _mm_mul_ps(audio_load_be(buf + in), vol);
+
+			if constexpr (First)
+			{
+				// Clear other channels
+				_mm_storeu_ps(out_buffer + out, _mm_movelh_ps(v, zero));
+				_mm_storeu_ps(out_buffer + out + channels, _mm_movehl_ps(zero, v));
+
+				if constexpr (channels == 8)
+				{
+					_mm_storeu_ps(out_buffer + out + 4, zero);
+					_mm_storeu_ps(out_buffer + out + channels + 4, zero);
+				}
+				else
+				{
+					audio_store_lo<true>(out_buffer + out + 4, zero);
+					audio_store_lo<true>(out_buffer + out + channels + 4, zero);
+				}
+			}
+			else
+			{
+				audio_store_lo<false>(out_buffer + out, v);
+				audio_store_lo<false>(out_buffer + out + channels, _mm_movehl_ps(v, v));
+			}
+		}
+	}
+	else
+	{
+		static_assert(InChannels == 8);
+
+		static constexpr float minus_3db = 0.707f;
+		const __m128 front_gain = _mm_setr_ps(minus_3db, minus_3db, 0.5f, 0.0f);
+		const __m128 half = _mm_set1_ps(0.5f);
+
+		for (u32 out = 0, in = 0; out < out_buffer_sz; out += channels, in += 8)
+		{
+			// L, R, C, LFE and RL, RR, SL, SR
+			const __m128 front = _mm_mul_ps(audio_load_be(buf + in), vol);
+			const __m128 back = _mm_mul_ps(audio_load_be(buf + in + 4), vol);
+
+			if constexpr (downmix == audio_downmix::downmix_to_stereo)
+			{
+				// Don't mix in the lfe as per dolby specification and based on documentation
+				const __m128 f = _mm_mul_ps(front, front_gain);
+				const __m128 b = _mm_mul_ps(back, half);
+				const __m128 sides = _mm_add_ps(b, _mm_movehl_ps(b, b));
+				const __m128 mid = _mm_shuffle_ps(f, f, _MM_SHUFFLE(2, 2, 2, 2));
+				audio_store_lo<First>(out_buffer + out, _mm_add_ps(_mm_add_ps(f, sides), mid));
+			}
+			else
+			{
+				audio_store<First>(out_buffer + out, front);
+				audio_store_lo<First>(out_buffer + out + 4, _mm_add_ps(back, _mm_movehl_ps(back, back)));
+			}
+		}
+	}
+}
+
 template <audio_downmix downmix>
 void cell_audio_thread::mix(float *out_buffer, s32 offset)
 {
@@ -891,6 +1042,24 @@ void cell_audio_thread::mix(float *out_buffer, s32 offset)
 
 		auto buf = port.get_vm_ptr(offset);
 
+		// Use the vectorized kernels unless the volume is changing
+		if (const auto param = port.level_set.load(); param.inc == 0.0f && (port.num_channels == 2 || port.num_channels == 8))
+		{
+			const f32 m = port.level * master_volume;
+
+			if (port.num_channels == 2)
+			{
+				first_mix ? audio_mix_port<downmix, 2, true>(out_buffer, buf, m) : audio_mix_port<downmix, 2, false>(out_buffer, buf, m);
+			}
+			else
+			{
+				first_mix ? audio_mix_port<downmix, 8, true>(out_buffer, buf, m) : audio_mix_port<downmix, 8, false>(out_buffer, buf, m);
+			}
+
+			first_mix = false;
+			continue;
+		}
+
 		static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
 		float m = master_volume;
 
@@ -157,6 +157,8 @@ struct content_permission final
 			success = true;
 		}
 
+		vfs::host::invalidate();
+
 		if (!success)
 		{
 			cellGame.fatal("Failed to clean directory '%s' (%s)", temp, fs::g_tls_error);
@@ -266,6 +268,8 @@ error_code cellHddGameCheck(ppu_thread& ppu, u32 version, vm::cptr<char> dirName
 			{
 				return {CELL_GAME_ERROR_ACCESS_ERROR, usrdir};
 			}
+
+			vfs::host::invalidate();
 		}
 
 		// Nuked until correctly reversed engineered
@@ -785,6 +789,8 @@ error_code cellGameDataCheckCreate2(ppu_thread& ppu, u32 version, vm::cptr<char>
 			{
 				return {CELL_GAME_ERROR_ACCESS_ERROR, usrdir};
 			}
+
+			vfs::host::invalidate();
 		}
 
 		if (setParam)
@@ -920,6 +926,8 @@ error_code cellGameCreateGameData(vm::ptr<CellGameSetInitParams> init, vm::ptr<c
 		return CELL_GAME_ERROR_ACCESS_ERROR; // ???
 	}
 
+	vfs::host::invalidate();
+
 	if (tmp_usrdirPath) strcpy_trunc(*tmp_usrdirPath, tmp_usrdir);
 
 	perm.temp = vfs::get(tmp_contentInfo);
@@ -7,6 +7,7 @@
 #include <stb_image.h>
 
 #include "Emu/Cell/lv2/sys_fs.h"
+#include "Emu/Cell/lv2/sys_sync.h"
 #include "cellGifDec.h"
 
 #include "util/asm.hpp"
@@ -193,7 +194,7 @@ error_code cellGifDecExtSetParameter()
 	return CELL_OK;
 }
 
-error_code cellGifDecDecodeData(PMainHandle mainHandle, PSubHandle subHandle, vm::ptr<u8> data, PDataCtrlParam dataCtrlParam, PDataOutInfo dataOutInfo)
+error_code cellGifDecDecodeData(ppu_thread& ppu, PMainHandle mainHandle, PSubHandle subHandle, vm::ptr<u8> data, PDataCtrlParam dataCtrlParam, PDataOutInfo dataOutInfo)
 {
 	cellGifDec.warning("cellGifDecDecodeData(mainHandle=*0x%x, subHandle=*0x%x, data=*0x%x, dataCtrlParam=*0x%x, dataOutInfo=*0x%x)", mainHandle, subHandle, data, dataCtrlParam, dataOutInfo);
 
@@ -203,102 +204,101 @@ error_code cellGifDecDecodeData(PMainHandle mainHandle, PSubHandle subHandle, vm
 	const u64 fileSize = subHandle->fileSize;
 	const CellGifDecOutParam& current_outParam = subHandle->outParam;
 
-	//Copy the GIF file to a buffer
-	std::unique_ptr<u8[]> gif(new u8[fileSize]);
+	if (current_outParam.outputColorSpace != CELL_GIFDEC_RGBA && current_outParam.outputColorSpace != CELL_GIFDEC_ARGB)
+	{
+		return CELL_GIFDEC_ERROR_ARG;
+	}
+
+	// Decode directly from the guest buffer, only files need to be read into memory
+	std::unique_ptr<u8[]> gif;
+	const u8* src = nullptr;
 
 	switch (subHandle->src.srcSelect)
 	{
 	case CELL_GIFDEC_BUFFER:
-		std::memcpy(gif.get(), subHandle->src.streamPtr.get_ptr(), fileSize);
+		src = static_cast<const u8*>(subHandle->src.streamPtr.get_ptr());
 		break;
 
 	case CELL_GIFDEC_FILE:
 	{
+		gif.reset(new u8[fileSize]);
 		auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 		file->file.seek(0);
 		file->file.read(gif.get(), fileSize);
+		src = gif.get();
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode GIF file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(gif.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
-
-	if (!image)
+	if (!src)
+	{
 		return CELL_GIFDEC_ERROR_STREAM_FORMAT;
+	}
 
-	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
-	const char nComponents = 4;
-	uint image_size = width * height * nComponents;
+	const u32 bytesPerLine = dataCtrlParam->outputBytesPerLine;
+	const bool argb = current_outParam.outputColorSpace == CELL_GIFDEC_ARGB;
 
-	switch(current_outParam.outputColorSpace)
-	{
-	case CELL_GIFDEC_RGBA:
+	// Decode the GIF file and write the output lines
+	auto decode = [&]()
 	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
+		int width, height, actual_components;
+		const auto image = std::unique_ptr<u8, decltype(&::free)>(stbi_load_from_memory(src, ::narrow<int>(fileSize), &width, &height, &actual_components, 4), &::free);
+
+		if (!image)
 		{
-			memcpy(data.get_ptr(), image.get(), image_size);
+			return false;
 		}
-	}
-	break;
 
-	case CELL_GIFDEC_ARGB:
-	{
-		if (bytesPerLine > width * nComponents) // Check if we need padding
+		const u32 widthBytes = width * 4;
+
+		// Contiguous output unless padding is needed
+		const u32 stride = std::max(bytesPerLine, widthBytes);
+
+		for (int i = 0; i < height; i++)
 		{
-			//TODO: find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
+			const u8* in = image.get() + widthBytes * i;
+			u8* out = data.get_ptr() + u64{stride} * i;
+
+			if (argb)
 			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * i;
-				for (int j = 0; j < linesize; j += nComponents)
+				for (u32 j = 0; j < widthBytes; j += 4)
 				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
+					// Set alpha (A8) as leftmost byte
+					u32 val;
+					std::memcpy(&val, in + j, 4);
+					val = std::rotl(val, 8);
+					std::memcpy(out + j, &val, 4);
 				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
 			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
+			else
 			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
+				std::memcpy(out, in, widthBytes);
 			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
 		}
-	}
-	break;
 
-	default:
-		return CELL_GIFDEC_ERROR_ARG;
+		return true;
+	};
+
+	// Large images are decoded on a separate thread so other PPU threads can run meanwhile
+	bool ok = false;
+
+	if (u64{subHandle->info.SWidth} * subHandle->info.SHeight >= 512 * 512)
+	{
+		lv2_obj::sleep_for_task(ppu, "GIF Decoder"sv, [&]() { ok = decode(); });
+
+		if (ppu.check_state())
+		{
+			return {};
+		}
 	}
+	else
+	{
+		ok = decode();
+	}
+
+	if (!ok)
+		return CELL_GIFDEC_ERROR_STREAM_FORMAT;
 
 	dataOutInfo->status = CELL_GIFDEC_DEC_STATUS_FINISH;
 	dataOutInfo->recordType = CELL_GIFDEC_RECORD_TYPE_IMAGE_DESC;
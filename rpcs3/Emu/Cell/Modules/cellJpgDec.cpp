@@ -7,6 +7,7 @@
 #include <stb_image.h>
 
 #include "Emu/Cell/lv2/sys_fs.h"
+#include "Emu/Cell/lv2/sys_sync.h"
 #include "cellJpgDec.h"
 
 #include "util/asm.hpp"
@@ -195,7 +196,7 @@ error_code cellJpgDecExtReadHeader()
 	return CELL_OK;
 }
 
-error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data, vm::cptr<CellJpgDecDataCtrlParam> dataCtrlParam, vm::ptr<CellJpgDecDataOutInfo> dataOutInfo)
+error_code cellJpgDecDecodeData(ppu_thread& ppu, u32 mainHandle, u32 subHandle, vm::ptr<u8> data, vm::cptr<CellJpgDecDataCtrlParam> dataCtrlParam, vm::ptr<CellJpgDecDataOutInfo> dataOutInfo)
 {
 	cellJpgDec.trace("cellJpgDecDecodeData(mainHandle=0x%x, subHandle=0x%x, data=*0x%x, dataCtrlParam=*0x%x, dataOutInfo=*0x%x)", mainHandle, subHandle, data, dataCtrlParam, dataOutInfo);
 
@@ -212,116 +213,130 @@ error_code cellJpgDecDecodeData(u32 mainHandle, u32 subHandle, vm::ptr<u8> data,
 	const u64& fileSize = subHandle_data->fileSize;
 	const CellJpgDecOutParam& current_outParam = subHandle_data->outParam;
 
-	//Copy the JPG file to a buffer
-	std::unique_ptr<u8[]> jpg(new u8[fileSize]);
+	// Number of components requested from the decoder
+	int nComponents;
+
+	switch (current_outParam.outputColorSpace)
+	{
+	case CELL_JPG_RGB: nComponents = 3; break;
+	case CELL_JPG_RGBA:
+	case CELL_JPG_ARGB: nComponents = 4; break;
+	case CELL_JPG_GRAYSCALE: nComponents = 1; break;
+
+	case CELL_JPG_YCbCr:
+	case CELL_JPG_UPSAMPLE_ONLY:
+	case CELL_JPG_GRAYSCALE_TO_ALPHA_RGBA:
+	case CELL_JPG_GRAYSCALE_TO_ALPHA_ARGB:
+		cellJpgDec.error("cellJpgDecDecodeData: Unsupported color space (%d)", current_outParam.outputColorSpace);
+		dataOutInfo->status = CELL_JPGDEC_DEC_STATUS_FINISH;
+
+		if (dataCtrlParam->outputBytesPerLine)
+			dataOutInfo->outputLines = static_cast<u32>(u64{subHandle_data->info.imageWidth} * subHandle_data->info.imageHeight / dataCtrlParam->outputBytesPerLine);
+
+		return CELL_OK;
+
+	default:
+		return CELL_JPGDEC_ERROR_ARG;
+	}
+
+	// Decode directly from the guest buffer, only files need to be read into memory
+	std::unique_ptr<u8[]> jpg;
+	const u8* src = nullptr;
 
 	switch (subHandle_data->src.srcSelect)
 	{
 	case CELL_JPGDEC_BUFFER:
-		std::memcpy(jpg.get(), vm::base(subHandle_data->src.streamPtr), fileSize);
+		src = static_cast<const u8*>(vm::base(subHandle_data->src.streamPtr));
 		break;
 
 	case CELL_JPGDEC_FILE:
 	{
+		jpg.reset(new u8[fileSize]);
 		auto file = idm::get<lv2_fs_object, lv2_file>(fd);
 		file->file.seek(0);
 		file->file.read(jpg.get(), fileSize);
+		src = jpg.get();
 		break;
 	}
 	default: break; // TODO
 	}
 
-	//Decode JPG file. (TODO: Is there any faster alternative? Can we do it without external libraries?)
-	int width, height, actual_components;
-	auto image = std::unique_ptr<unsigned char,decltype(&::free)>
-		(
-			stbi_load_from_memory(jpg.get(), ::narrow<int>(fileSize), &width, &height, &actual_components, 4),
-			&::free
-		);
-
-	if (!image)
+	if (!src)
+	{
 		return CELL_JPGDEC_ERROR_STREAM_FORMAT;
+	}
 
 	const bool flip = current_outParam.outputMode == CELL_JPGDEC_BOTTOM_TO_TOP;
-	const int bytesPerLine = static_cast<int>(dataCtrlParam->outputBytesPerLine);
-	usz image_size = width * height;
+	const u32 bytesPerLine = dataCtrlParam->outputBytesPerLine;
+	const bool argb = current_outParam.outputColorSpace == CELL_JPG_ARGB;
 
-	switch(current_outParam.outputColorSpace)
-	{
-	case CELL_JPG_RGB:
-	case CELL_JPG_RGBA:
+	int width = 0, height = 0;
+
+	// Decode the JPG file (stb_image uses its SSE2 IDCT and color conversion) and write the output lines
+	auto decode = [&]()
 	{
-		const char nComponents = current_outParam.outputColorSpace == CELL_JPG_RGBA ? 4 : 3;
-		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
-		{
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			for (int i = 0; i < height; i++)
-			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				memcpy(&data[dstOffset], &image.get()[srcOffset], linesize);
-			}
-		}
-		else
+		int actual_components;
+		const auto image = std::unique_ptr<u8, decltype(&::free)>(stbi_load_from_memory(src, ::narrow<int>(fileSize), &width, &height, &actual_components, nComponents), &::free);
+
+		if (!image)
 		{
-			memcpy(data.get_ptr(), image.get(), image_size);
+			return false;
 		}
-	}
-	break;
 
-	case CELL_JPG_ARGB:
-	{
-		const int nComponents = 4;
-		image_size *= nComponents;
-		if (bytesPerLine > width * nComponents || flip) //check if we need padding
+		const u32 widthBytes = width * nComponents;
+
+		// Contiguous output unless padding or flipping is needed
+		const bool pad = bytesPerLine > widthBytes || flip;
+		const u32 stride = pad ? bytesPerLine : widthBytes;
+		const u32 linesize = pad ? std::min(bytesPerLine, widthBytes) : widthBytes;
+
+		for (int i = 0; i < height; i++)
 		{
-			//TODO: Find out if we can't do padding without an extra copy
-			const int linesize = std::min(bytesPerLine, width * nComponents);
-			const auto output = std::make_unique<char[]>(linesize);
-			for (int i = 0; i < height; i++)
+			const u8* in = image.get() + widthBytes * (flip ? height - i - 1 : i);
+			u8* out = data.get_ptr() + u64{stride} * i;
+
+			if (argb)
 			{
-				const int dstOffset = i * bytesPerLine;
-				const int srcOffset = width * nComponents * (flip ? height - i - 1 : i);
-				for (int j = 0; j < linesize; j += nComponents)
+				for (u32 j = 0; j + 4 <= linesize; j += 4)
 				{
-					output[j + 0] = image.get()[srcOffset + j + 3];
-					output[j + 1] = image.get()[srcOffset + j + 0];
-					output[j + 2] = image.get()[srcOffset + j + 1];
-					output[j + 3] = image.get()[srcOffset + j + 2];
+					// Set alpha (A8) as leftmost byte
+					u32 val;
+					std::memcpy(&val, in + j, 4);
+					val = std::rotl(val, 8);
+					std::memcpy(out + j, &val, 4);
 				}
-				std::memcpy(&data[dstOffset], output.get(), linesize);
 			}
-		}
-		else
-		{
-			const auto img = std::make_unique<uint[]>(image_size);
-			uint* source_current = reinterpret_cast<uint*>(image.get());
-			uint* dest_current = img.get();
-			for (uint i = 0; i < image_size / nComponents; i++)
+			else
 			{
-				uint val = *source_current;
-				*dest_current = (val >> 24) | (val << 8); // set alpha (A8) as leftmost byte
-				source_current++;
-				dest_current++;
+				std::memcpy(out, in, linesize);
 			}
-			std::memcpy(data.get_ptr(), img.get(), image_size);
 		}
-	}
-	break;
 
-	case CELL_JPG_GRAYSCALE:
-	case CELL_JPG_YCbCr:
-	case CELL_JPG_UPSAMPLE_ONLY:
-	case CELL_JPG_GRAYSCALE_TO_ALPHA_RGBA:
-	case CELL_JPG_GRAYSCALE_TO_ALPHA_ARGB:
-		cellJpgDec.error("cellJpgDecDecodeData: Unsupported color space (%d)", current_outParam.outputColorSpace);
-	break;
+		return true;
+	};
 
-	default:
-		return CELL_JPGDEC_ERROR_ARG;
+	// Large images are decoded on a separate thread so other PPU threads can run meanwhile
+	bool ok = false;
+
+	if (u64{subHandle_data->info.imageWidth} * subHandle_data->info.imageHeight >= 512 * 512)
+	{
+		lv2_obj::sleep_for_task(ppu, "JPG Decoder"sv, [&]() { ok = decode(); });
+
+		if (ppu.check_state())
+		{
+			return {};
+		}
+	}
+	else
+	{
+		ok = decode();
 	}
 
+	if (!ok)
+		return CELL_JPGDEC_ERROR_STREAM_FORMAT;
+
+	const usz image_size = usz{static_cast<u32>(width)} * height * nComponents;
+
 	dataOutInfo->status = CELL_JPGDEC_DEC_STATUS_FINISH;
 
 	if(dataCtrlParam->outputBytesPerLine)
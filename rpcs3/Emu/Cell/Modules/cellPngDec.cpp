@@ -3,6 +3,7 @@
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/lv2/sys_fs.h"
+#include "Emu/Cell/lv2/sys_sync.h"
 #include "png.h"
 #include "cellPng.h"
 #include "cellPngDec.h"
@@ -774,6 +775,7 @@ error_code pngDecodeData(ppu_thread& ppu, PHandle handle, PStream stream, vm::pt
 
 		// Decode the image
 		// todo: commandptr
+		auto decode = [&]()
 		{
 			for (u32 j = 0; j < stream->passes; j++)
 			{
@@ -784,6 +786,21 @@ error_code pngDecodeData(ppu_thread& ppu, PHandle handle, PStream stream, vm::pt
 				}
 			}
 			png_read_end(stream->png_ptr, stream->info_ptr);
+		};
+
+		// Large images are decoded on a separate thread so other PPU threads can run meanwhile
+		if (u64{stream->out_param.outputHeight} * stream->out_param.outputWidthByte >= 1024 * 1024)
+		{
+			lv2_obj::sleep_for_task(ppu, "PNG Decoder"sv, decode);
+
+			if (ppu.check_state())
+			{
+				return {};
+			}
+		}
+		else
+		{
+			decode();
 		}
 	}
 
@@ -232,6 +232,7 @@ static error_code select_and_delete(ppu_thread& ppu)
 			// Remove directory
 			const std::string path = base_dir + save_entries[selected].escaped;
 			fs::remove_all(path);
+			vfs::host::invalidate();
 
 			// Remove entry from the list and reset the selection
 			save_entries.erase(save_entries.cbegin() + selected);
@@ -980,6 +981,7 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 
 				// Cleanup
 				fs::remove_all(old_path);
+				vfs::host::invalidate();
 			}
 			else
 			{
@@ -1525,6 +1527,8 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 		return CELL_SAVEDATA_ERROR_ACCESS_ERROR;
 	}
 
+	vfs::host::invalidate();
+
 	// Enter the loop where the save files are read/created/deleted
 	std::map<std::string, std::pair<s64, s64>> all_times;
 	std::map<std::string, fs::file> all_files;
@@ -1952,6 +1956,7 @@ static NEVER_INLINE error_code savedata_op(ppu_thread& ppu, u32 operation, u32 v
 
 		// Remove backup again (TODO: may be changed to persistent backup implementation)
 		fs::remove_all(old_path);
+		vfs::host::invalidate();
 	}
 
 	if (savedata_result + 0u == CELL_SAVEDATA_ERROR_CBRESULT)
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "Emu/IdManager.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/system_config.h"
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/lv2/sys_sync.h"
 #include "Emu/Cell/lv2/sys_ppu_thread.h"
@@ -37,6 +38,8 @@ extern "C"
 #include <variant>
 #include "util/asm.hpp"
 
+#include <emmintrin.h>
+
 std::mutex g_mutex_avcodec_open2;
 
 LOG_CHANNEL(cellVdec);
@@ -184,6 +187,12 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_alloc_context3() failed (type=0x%x)", type);
 		}
 
+		// Slice threads decode parts of the same picture and add no delay, frame threads add a delay of (thread_count - 1) pictures
+		// which is drained at the end of the sequence. Frame threading is opt-in: games waiting for PICOUT after each AU would stall.
+		// 0 lets ffmpeg pick the thread count, 1 disables threading.
+		ctx->thread_count = g_cfg.core.vdec_threads;
+		ctx->thread_type = g_cfg.core.vdec_frame_threading ? FF_THREAD_FRAME | FF_THREAD_SLICE : FF_THREAD_SLICE;
+
 		AVDictionary* opts{};
 		av_dict_set(&opts, "refcounted_frames", "1", 0);
 
@@ -277,6 +286,9 @@ struct vdec_context final
 						au_mode == CELL_VDEC_DEC_MODE_NORMAL ? AVDISCARD_DEFAULT :
 						au_mode == CELL_VDEC_DEC_MODE_B_SKIP ? AVDISCARD_NONREF : AVDISCARD_NONINTRA;
 
+					// Travels with the picture through reordering and frame threads
+					ctx->reordered_opaque = static_cast<s64>(au_usrd);
+
 					cellVdec.trace("AU decoding: size=0x%x, pts=0x%llx, dts=0x%llx, userdata=0x%llx", au_size, au_pts, au_dts, au_usrd);
 				}
 				else
@@ -286,14 +298,10 @@ struct vdec_context final
 					cellVdec.trace("End sequence...");
 				}
 
-				while (out_max)
+				if (out_max)
 				{
-					if (cmd->mode == -1)
-					{
-						break;
-					}
-
-					if (int ret = avcodec_send_packet(ctx, &packet); ret < 0)
+					// End of sequence: enter draining mode to get the pictures still held by the decoder
+					if (int ret = avcodec_send_packet(ctx, cmd->mode != -1 ? &packet : nullptr); ret < 0)
 					{
 						char av_error[AV_ERROR_MAX_STRING_SIZE];
 						av_make_error_string(av_error, AV_ERROR_MAX_STRING_SIZE, ret);
@@ -313,7 +321,7 @@ struct vdec_context final
 
 						if (int ret = avcodec_receive_frame(ctx, frame.avf.get()); ret < 0)
 						{
-							if (ret == AVERROR(EAGAIN))
+							if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF)
 							{
 								break;
 							}
@@ -348,7 +356,7 @@ struct vdec_context final
 
 						frame.pts = next_pts;
 						frame.dts = next_dts;
-						frame.userdata = au_usrd;
+						frame.userdata = static_cast<u64>(frame->reordered_opaque);
 
 						if (frc_set)
 						{
@@ -423,9 +431,10 @@ struct vdec_context final
 						lv2_obj::sleep(ppu);
 					}
 
-					if (cmd->mode != -1)
+					if (cmd->mode == -1)
 					{
-						break;
+						// Leave draining mode
+						avcodec_flush_buffers(ctx);
 					}
 				}
 
@@ -791,6 +800,129 @@ error_code cellVdecDecodeAuEx2()
 	return CELL_OK;
 }
 
+// BT.601 limited range YUV420P conversion, matching the default swscale tables (fixed point with 3 fractional bits)
+static constexpr s16 c_vdec_y_mul = 9535;  // 1.164 * 8192
+static constexpr s16 c_vdec_rv_mul = 13074; // 1.596 * 8192
+static constexpr s16 c_vdec_gu_mul = 3203;  // 0.391 * 8192
+static constexpr s16 c_vdec_gv_mul = 6660;  // 0.813 * 8192
+static constexpr s16 c_vdec_bu_mul = 16531; // 2.018 * 8192
+
+template <bool RGBA>
+static void vdec_yuv420p_to_rgb_row(const u8* y_row, const u8* u_row, const u8* v_row, u8* dst, u32 width, u8 alpha)
+{
+	u32 x = 0;
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i y_bias = _mm_set1_epi16(16);
+	const __m128i uv_bias = _mm_set1_epi16(128);
+	const __m128i round = _mm_set1_epi16(4);
+	const __m128i a = _mm_set1_epi8(static_cast<s8>(alpha));
+
+	for (; x + 16 <= width; x += 16)
+	{
+		const __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y_row + x));
+		const __m128i u = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u_row + x / 2)), zero), uv_bias), 6);
+		const __m128i v = _mm_slli_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v_row + x / 2)), zero), uv_bias), 6);
+
+		// Chroma terms for 8 pixel pairs
+		const __m128i rv = _mm_mulhi_epi16(v, _mm_set1_epi16(c_vdec_rv_mul));
+		const __m128i guv = _mm_add_epi16(_mm_mulhi_epi16(u, _mm_set1_epi16(c_vdec_gu_mul)), _mm_mulhi_epi16(v, _mm_set1_epi16(c_vdec_gv_mul)));
+		const __m128i bu = _mm_mulhi_epi16(u, _mm_set1_epi16(c_vdec_bu_mul));
+
+		__m128i r[2], g[2], b[2];
+
+		for (int i = 0; i < 2; i++)
+		{
+			const __m128i y16 = _mm_slli_epi16(_mm_sub_epi16(i ? _mm_unpackhi_epi8(y8, zero) : _mm_unpacklo_epi8(y8, zero), y_bias), 6);
+			const __m128i yv = _mm_add_epi16(_mm_mulhi_epi16(y16, _mm_set1_epi16(c_vdec_y_mul)), round);
+
+			r[i] = _mm_srai_epi16(_mm_add_epi16(yv, i ? _mm_unpackhi_epi16(rv, rv) : _mm_unpacklo_epi16(rv, rv)), 3);
+			g[i] = _mm_srai_epi16(_mm_sub_epi16(yv, i ? _mm_unpackhi_epi16(guv, guv) : _mm_unpacklo_epi16(guv, guv)), 3);
+			b[i] = _mm_srai_epi16(_mm_add_epi16(yv, i ? _mm_unpackhi_epi16(bu, bu) : _mm_unpacklo_epi16(bu, bu)), 3);
+		}
+
+		const __m128i r8 = _mm_packus_epi16(r[0], r[1]);
+		const __m128i g8 = _mm_packus_epi16(g[0], g[1]);
+		const __m128i b8 = _mm_packus_epi16(b[0], b[1]);
+
+		// Interleave in memory order
+		const __m128i c01 = RGBA ? _mm_unpacklo_epi8(r8, g8) : _mm_unpacklo_epi8(a, r8);
+		const __m128i c23 = RGBA ? _mm_unpacklo_epi8(b8, a) : _mm_unpacklo_epi8(g8, b8);
+		const __m128i c01h = RGBA ? _mm_unpackhi_epi8(r8, g8) : _mm_unpackhi_epi8(a, r8);
+		const __m128i c23h = RGBA ? _mm_unpackhi_epi8(b8, a) : _mm_unpackhi_epi8(g8, b8);
+
+		__m128i* out = reinterpret_cast<__m128i*>(dst + x * 4);
+		_mm_storeu_si128(out + 0, _mm_unpacklo_epi16(c01, c23));
+		_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(c01, c23));
+		_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(c01h, c23h));
+		_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(c01h, c23h));
+	}
+
+	for (; x < width; x++)
+	{
+		const s32 u = (u_row[x / 2] - 128) * 64;
+		const s32 v = (v_row[x / 2] - 128) * 64;
+		const s32 yv = ((y_row[x] - 16) * 64 * c_vdec_y_mul >> 16) + 4;
+
+		const u8 r = static_cast<u8>(std::clamp((yv + (v * c_vdec_rv_mul >> 16)) >> 3, 0, 255));
+		const u8 g = static_cast<u8>(std::clamp((yv - ((u * c_vdec_gu_mul >> 16) + (v * c_vdec_gv_mul >> 16))) >> 3, 0, 255));
+		const u8 b = static_cast<u8>(std::clamp((yv + (u * c_vdec_bu_mul >> 16)) >> 3, 0, 255));
+
+		u8* out = dst + x * 4;
+
+		if constexpr (RGBA)
+		{
+			out[0] = r, out[1] = g, out[2] = b, out[3] = alpha;
+		}
+		else
+		{
+			out[0] = alpha, out[1] = r, out[2] = g, out[3] = b;
+		}
+	}
+}
+
+// Convert a YUV420P picture straight into the guest buffer, returns false if the output format must go through swscale
+static bool vdec_convert_picture(const AVFrame* frame, u32 format_type, u8 alpha, u8* out)
+{
+	const u32 w = frame->width;
+	const u32 h = frame->height;
+
+	switch (format_type)
+	{
+	case CELL_VDEC_PICFMT_ARGB32_ILV:
+	case CELL_VDEC_PICFMT_RGBA32_ILV:
+	{
+		const auto convert_row = format_type == CELL_VDEC_PICFMT_RGBA32_ILV ? &vdec_yuv420p_to_rgb_row<true> : &vdec_yuv420p_to_rgb_row<false>;
+
+		for (u32 y = 0; y < h; y++)
+		{
+			convert_row(frame->data[0] + y * frame->linesize[0], frame->data[1] + y / 2 * frame->linesize[1], frame->data[2] + y / 2 * frame->linesize[2], out + y * w * 4, w, alpha);
+		}
+
+		return true;
+	}
+	case CELL_VDEC_PICFMT_YUV420_PLANAR:
+	{
+		// Same layout as the decoder output, only the padding is removed
+		for (u32 p = 0; p < 3; p++)
+		{
+			const u32 pw = p ? w / 2 : w;
+			const u32 ph = p ? h / 2 : h;
+
+			for (u32 y = 0; y < ph; y++)
+			{
+				std::memcpy(out + y * pw, frame->data[p] + y * frame->linesize[p], pw);
+			}
+
+			out += pw * ph;
+		}
+
+		return true;
+	}
+	default: return false;
+	}
+}
+
 error_code cellVdecGetPicture(u32 handle, vm::cptr<CellVdecPicFormat> format, vm::ptr<u8> outBuff)
 {
 	cellVdec.trace("cellVdecGetPicture(handle=0x%x, format=*0x%x, outBuff=*0x%x)", handle, format, outBuff);
@@ -843,6 +975,13 @@ error_code cellVdecGetPicture(u32 handle, vm::cptr<CellVdecPicFormat> format, vm
 		const int w = frame->width;
 		const int h = frame->height;
 
+		// TODO: color matrix
+
+		if (frame->format == AV_PIX_FMT_YUV420P && w % 2 == 0 && h % 2 == 0 && vdec_convert_picture(frame.avf.get(), format->formatType, format->alpha, outBuff.get_ptr()))
+		{
+			return CELL_OK;
+		}
+
 		AVPixelFormat out_f = AV_PIX_FMT_YUV420P;
 
 		std::unique_ptr<u8[]> alpha_plane;
@@ -860,8 +999,6 @@ error_code cellVdecGetPicture(u32 handle, vm::cptr<CellVdecPicFormat> format, vm
 		}
 		}
 
-		// TODO: color matrix
-
 		if (alpha_plane)
 		{
 			std::memset(alpha_plane.get(), format->alpha, w * h);
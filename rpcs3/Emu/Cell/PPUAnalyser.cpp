@@ -13,6 +13,74 @@ LOG_CHANNEL(ppu_validator);
 
 const ppu_decoder<ppu_itype> s_ppu_itype;
 
+// Insert value into sorted list if not present
+static void ppu_add_unique(std::vector<u32>& list, u32 value)
+{
+	const auto found = std::lower_bound(list.begin(), list.end(), value);
+
+	if (found == list.end() || *found != value)
+	{
+		list.insert(found, value);
+	}
+}
+
+// Open addressing set of analysed addresses (~0u is reserved)
+class ppu_addr_set
+{
+	static constexpr u32 s_empty = ~0u;
+
+	std::vector<u32> m_table;
+	u32 m_shift;
+	usz m_size = 0;
+
+	usz slot(u32 addr) const
+	{
+		return (addr * 0x9e3779b97f4a7c15ull) >> m_shift;
+	}
+
+public:
+	explicit ppu_addr_set(u32 capacity_log2)
+		: m_table(usz{1} << capacity_log2, s_empty)
+		, m_shift(64 - capacity_log2)
+	{
+	}
+
+	bool insert(u32 addr)
+	{
+		if (m_size * 2 >= m_table.size())
+		{
+			// Rehash at 50% load
+			std::vector<u32> old(m_table.size() * 2, s_empty);
+			m_table.swap(old);
+			m_shift--;
+			m_size = 0;
+
+			for (u32 value : old)
+			{
+				if (value != s_empty)
+				{
+					insert(value);
+				}
+			}
+		}
+
+		for (usz i = slot(addr), mask = m_table.size() - 1;; i = (i + 1) & mask)
+		{
+			if (m_table[i] == addr)
+			{
+				return false;
+			}
+
+			if (m_table[i] == s_empty)
+			{
+				m_table[i] = addr;
+				m_size++;
+				return true;
+			}
+		}
+	}
+};
+
 template<>
 void fmt_class_string<ppu_attr>::format(std::string& out, u64 arg)
 {
@@ -547,8 +615,13 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	// Function analysis workload
 	std::vector<std::reference_wrapper<ppu_function>> func_queue;
 
-	// Known references (within segs, addr and value alignment = 4)
-	std::set<u32> addr_heap{entry};
+	// Known references (within segs, addr and value alignment = 4), sorted once collected
+	std::vector<u32> addr_heap;
+
+	auto is_referenced = [&](u32 addr)
+	{
+		return std::binary_search(addr_heap.cbegin(), addr_heap.cend(), addr);
+	};
 
 	// Register new function
 	auto add_func = [&](u32 addr, u32 toc, u32 caller) -> ppu_function&
@@ -558,7 +631,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		if (caller)
 		{
 			// Register caller
-			func.callers.emplace(caller);
+			ppu_add_unique(func.callers, caller);
 		}
 
 		if (func.addr)
@@ -603,7 +676,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 				{
 					// New function
 					ppu_log.trace("OPD*: [0x%x] 0x%x (TOC=0x%x)", ptr, ptr[0], ptr[1]);
-					add_func(*ptr, addr_heap.count(ptr.addr()) ? toc : 0, 0);
+					add_func(*ptr, is_referenced(ptr.addr()) ? toc : 0, 0);
 					ptr++;
 				}
 			}
@@ -617,7 +690,9 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		return it == known_functions.end() ? end : *it;
 	};
 
-	// Find references indiscriminately
+	// Find references indiscriminately (collect in a bitmap, one bit per instruction)
+	std::vector<u64> ref_bits(((end > start ? end - start : 0) / 4 + 63) / 64);
+
 	for (const auto& seg : segs)
 	{
 		if (!seg.addr) continue;
@@ -626,24 +701,29 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		{
 			const u32 value = *ptr;
 
-			if (value % 4)
+			if (value % 4 == 0 && value >= start && value < end)
 			{
-				continue;
+				const u32 index = (value - start) / 4;
+				ref_bits[index / 64] |= u64{1} << (index % 64);
 			}
+		}
+	}
 
-			for (const auto& _seg : segs)
-			{
-				if (!_seg.addr) continue;
-
-				if (value >= start && value < end)
-				{
-					addr_heap.emplace(value);
-					break;
-				}
-			}
+	for (usz i = 0; i < ref_bits.size(); i++)
+	{
+		for (u64 bits = ref_bits[i]; bits; bits &= bits - 1)
+		{
+			addr_heap.emplace_back(start + ::narrow<u32>(i * 64 + std::countr_zero(bits)) * 4);
 		}
 	}
 
+	ref_bits = {};
+
+	if (const auto found = std::lower_bound(addr_heap.begin(), addr_heap.end(), entry); found == addr_heap.end() || *found != entry)
+	{
+		addr_heap.insert(found, entry);
+	}
+
 	// Find OPD section
 	for (const auto& sec : secs)
 	{
@@ -699,7 +779,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 			ppu_log.trace("OPD: [0x%x] 0x%x (TOC=0x%x)", ptr, addr, toc);
 
 			TOCs.emplace(toc);
-			auto& func = add_func(addr, addr_heap.count(ptr.addr()) ? toc : 0, 0);
+			auto& func = add_func(addr, is_referenced(ptr.addr()) ? toc : 0, 0);
 			func.attr += ppu_attr::known_addr;
 			known_functions.emplace(addr);
 		}
@@ -901,7 +981,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 					func.size = 0x4;
 					func.blocks.emplace(func.addr, func.size);
 					func.attr += new_func.attr & ppu_attr::no_return;
-					func.calls.emplace(target);
+					ppu_add_unique(func.calls, target);
 					func.trampoline = 0;
 					continue;
 				}
@@ -929,7 +1009,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 					func.size = 0x10;
 					func.blocks.emplace(func.addr, func.size);
 					func.attr += new_func.attr & ppu_attr::no_return;
-					func.calls.emplace(target);
+					ppu_add_unique(func.calls, target);
 					func.trampoline = 0;
 					continue;
 				}
@@ -1017,7 +1097,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 					func.size = 0x1C;
 					func.blocks.emplace(func.addr, func.size);
 					func.attr += new_func.attr & ppu_attr::no_return;
-					func.calls.emplace(target);
+					ppu_add_unique(func.calls, target);
 					func.trampoline = toc_add;
 					continue;
 				}
@@ -1064,7 +1144,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 					func.size = 0x10;
 					func.blocks.emplace(func.addr, func.size);
 					func.attr += new_func.attr & ppu_attr::no_return;
-					func.calls.emplace(target);
+					ppu_add_unique(func.calls, target);
 					func.trampoline = toc_add;
 					continue;
 				}
@@ -1183,7 +1263,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 			const u32 func_end2 = _next == fmap.end() ? func_end : std::min<u32>(_next->first, func_end);
 
 			// Set more block entries
-			std::for_each(addr_heap.lower_bound(func.addr), addr_heap.lower_bound(func_end2), add_block);
+			std::for_each(std::lower_bound(addr_heap.cbegin(), addr_heap.cend(), func.addr), std::lower_bound(addr_heap.cbegin(), addr_heap.cend(), func_end2), add_block);
 		}
 
 		const bool was_empty = block_queue.empty();
@@ -1396,7 +1476,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 					{
 						if (target < func.addr || target >= func.addr + func.size)
 						{
-							func.calls.emplace(target);
+							ppu_add_unique(func.calls, target);
 							add_func(target, func.toc ? func.toc + func.trampoline : 0, func.addr);
 						}
 					}
@@ -1586,7 +1666,7 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	std::vector<std::pair<u32, u32>> block_queue;
 	block_queue.reserve(128000);
 
-	std::unordered_set<u32> block_set;
+	ppu_addr_set block_set(12);
 
 	// Check relocations which may involve block addresses (usually it's type 1)
 	for (auto& rel : this->relocs)
@@ -1616,9 +1696,9 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 		case 109:
 		case 110:
 		{
-			ppu_log.trace("Added block from reloc: 0x%x (0x%x, %u) (heap=%d)", target, rel.addr, rel.type, addr_heap.count(target));
+			ppu_log.trace("Added block from reloc: 0x%x (0x%x, %u) (heap=%d)", target, rel.addr, rel.type, is_referenced(target));
 			block_queue.emplace_back(target, 0);
-			block_set.emplace(target);
+			block_set.insert(target);
 			continue;
 		}
 		default:
@@ -1640,10 +1720,9 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 	// Add entries from patches (on per-instruction basis)
 	for (u32 addr : applied)
 	{
-		if (addr % 4 == 0 && addr >= start && addr < segs[0].addr + segs[0].size && !block_set.count(addr))
+		if (addr % 4 == 0 && addr >= start && addr < segs[0].addr + segs[0].size && block_set.insert(addr))
 		{
 			block_queue.emplace_back(addr, addr + 4);
-			block_set.emplace(addr);
 		}
 	}
 
@@ -1720,11 +1799,10 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 
 						if (target != i_pos && found == fmap.cend())
 						{
-							if (block_set.count(target) == 0)
+							if (block_set.insert(target))
 							{
 								ppu_log.trace("Block target found: 0x%x (i_pos=0x%x)", target, i_pos);
 								block_queue.emplace_back(target, 0);
-								block_set.emplace(target);
 							}
 						}
 					}
@@ -1778,11 +1856,10 @@ void ppu_module::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::b
 				// Register fallback target
 				const auto found = fmap.find(lim);
 
-				if (found == fmap.cend() && block_set.count(lim) == 0)
+				if (found == fmap.cend() && block_set.insert(lim))
 				{
 					ppu_log.trace("Block target found: 0x%x (i_pos=0x%x)", lim, i_pos);
 					block_queue.emplace_back(lim, 0);
-					block_set.emplace(lim);
 				}
 			}
 
@@ -32,8 +32,8 @@ struct ppu_function
 	u32 trampoline = 0;
 
 	std::map<u32, u32> blocks{}; // Basic blocks: addr -> size
-	std::set<u32> calls{}; // Set of called functions
-	std::set<u32> callers{};
+	std::vector<u32> calls{}; // Called functions (sorted)
+	std::vector<u32> callers{}; // Calling functions (sorted)
 	std::string name{}; // Function name
 };
 
@@ -3,6 +3,7 @@
 #include "Utilities/JIT.h"
 
 #include "PPUModule.h"
+#include "util/sysinfo.hpp"
 
 // Get function name by FNID
 extern std::string ppu_get_function_name(const std::string& _module, u32 fnid)
@@ -1949,3 +1950,154 @@ u32 ppu_function_manager::add_function(ppu_function_t function)
 }
 
 DECLARE(ppu_function_manager::addr);
+
+extern std::string ppu_get_syscall_name(u64 code);
+
+extern std::vector<std::string> g_ppu_function_names;
+
+static shared_mutex s_call_stats_mutex;
+
+// Live per-thread tables
+static std::vector<std::pair<const void*, u32>> s_call_stats_sources;
+
+// Stats of finished threads
+static std::vector<std::array<u64, 4>> s_call_stats_acc;
+
+ppu_call_stats::ppu_call_stats(bool timing) noexcept
+	: m_size(timing ? hle_base + ::size32(ppu_function_manager::get()) : hle_base)
+	, m_data(std::make_unique<entry[]>(m_size))
+{
+	std::lock_guard lock(s_call_stats_mutex);
+
+	s_call_stats_sources.emplace_back(m_data.get(), m_size);
+}
+
+ppu_call_stats::~ppu_call_stats()
+{
+	std::lock_guard lock(s_call_stats_mutex);
+
+	if (s_call_stats_acc.size() < m_size)
+	{
+		s_call_stats_acc.resize(m_size);
+	}
+
+	for (u32 i = 0; i < m_size; i++)
+	{
+		const entry& e = m_data[i];
+		auto& acc = s_call_stats_acc[i];
+
+		acc[0] += e.calls;
+		acc[1] += e.blocked;
+		acc[2] += e.ticks;
+		acc[3] = std::max(acc[3], e.max);
+	}
+
+	s_call_stats_sources.erase(std::find(s_call_stats_sources.begin(), s_call_stats_sources.end(), std::make_pair(static_cast<const void*>(m_data.get()), m_size)));
+}
+
+std::vector<ppu_call_stat_summary> ppu_call_stats::query(bool syscalls_only) noexcept
+{
+	std::vector<std::array<u64, 4>> totals;
+
+	{
+		reader_lock lock(s_call_stats_mutex);
+
+		totals = s_call_stats_acc;
+
+		// Read live tables without draining them (owners keep writing them without locking)
+		for (const auto& [ptr, size] : s_call_stats_sources)
+		{
+			if (totals.size() < size)
+			{
+				totals.resize(size);
+			}
+
+			const auto data = static_cast<const entry*>(ptr);
+
+			for (u32 i = 0; i < size; i++)
+			{
+				auto& total = totals[i];
+
+				total[0] += atomic_storage<u64>::load(data[i].calls);
+				total[1] += atomic_storage<u64>::load(data[i].blocked);
+				total[2] += atomic_storage<u64>::load(data[i].ticks);
+				total[3] = std::max<u64>(total[3], atomic_storage<u64>::load(data[i].max));
+			}
+		}
+	}
+
+	if (syscalls_only && totals.size() > hle_base)
+	{
+		totals.resize(hle_base);
+	}
+
+	const u64 freq = utils::get_tsc_freq();
+
+	const auto to_ns = [&](u64 ticks) -> u64
+	{
+		return freq ? static_cast<u64>(ticks * (1000'000'000. / freq)) : ticks;
+	};
+
+	std::vector<ppu_call_stat_summary> result;
+
+	for (u32 i = 0; i < totals.size(); i++)
+	{
+		const auto& total = totals[i];
+
+		if (!total[0])
+		{
+			continue;
+		}
+
+		ppu_call_stat_summary& out = result.emplace_back();
+
+		if (i < hle_base)
+		{
+			out.name = ppu_get_syscall_name(i);
+		}
+		else if (i - hle_base < g_ppu_function_names.size() && !g_ppu_function_names[i - hle_base].empty())
+		{
+			out.name = g_ppu_function_names[i - hle_base];
+		}
+		else
+		{
+			out.name = fmt::format("HLE function %u", i - hle_base);
+		}
+
+		out.calls = total[0];
+		out.blocked = total[1];
+		out.total = to_ns(total[2]);
+		out.max = to_ns(total[3]);
+	}
+
+	std::sort(result.begin(), result.end(), [](const ppu_call_stat_summary& a, const ppu_call_stat_summary& b)
+	{
+		return a.total != b.total ? a.total > b.total : a.calls > b.calls;
+	});
+
+	return result;
+}
+
+std::string ppu_call_stats::format(const std::vector<ppu_call_stat_summary>& stats)
+{
+	std::string out = fmt::format("%-48s %12s %12s %12s %12s %12s", "Function", "Calls", "Blocked", "Total (ms)", "Avg (us)", "Max (us)");
+
+	for (const auto& stat : stats)
+	{
+		fmt::append(out, "\n%-48s %12u %12u %12.3f %12.3f %12.3f", stat.name, stat.calls, stat.blocked, stat.total / 1000'000., stat.total / 1000. / stat.calls, stat.max / 1000.);
+	}
+
+	return out;
+}
+
+void ppu_call_stats::report() noexcept
+{
+	if (const auto stats = query(); !stats.empty())
+	{
+		ppu_log.notice("PPU call stats:\n%s", format(stats));
+	}
+
+	std::lock_guard lock(s_call_stats_mutex);
+
+	s_call_stats_acc.clear();
+}
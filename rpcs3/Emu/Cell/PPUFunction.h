@@ -3,16 +3,24 @@
 #include "PPUThread.h"
 
 #include "util/v128.hpp"
+#include "util/asm.hpp"
 
 using ppu_function_t = bool(*)(ppu_thread&);
 
 // BIND_FUNC macro "converts" any appropriate HLE function to ppu_function_t, binding it to PPU thread context.
-#define BIND_FUNC(func, ...) (static_cast<ppu_function_t>([](ppu_thread& ppu) -> bool {\
+#define BIND_FUNC(func, ...) BIND_FUNC_STAT(func, 0, __VA_ARGS__)
+
+// Same as BIND_FUNC, also accounting calls in ppu_call_stats for the given HLE function index (0 = none).
+#define BIND_FUNC_STAT(func, stat_index, ...) (static_cast<ppu_function_t>([](ppu_thread& ppu) -> bool {\
 	const auto old_f = ppu.current_function;\
 	if (!old_f) ppu.last_function = #func;\
 	ppu.current_function = #func;\
 	std::memcpy(ppu.syscall_args, ppu.gpr + 3, sizeof(ppu.syscall_args)); \
+	const u32 stat_id = stat_index;\
+	const u64 stat_start = stat_id ? ppu.call_stats->start() : 0;\
+	const u32 stat_sleeps = ppu.sleep_count;\
 	ppu_func_detail::do_call(ppu, func);\
+	if (stat_start) ppu.call_stats->push(ppu_call_stats::hle_base + stat_id, stat_start, ppu.sleep_count != stat_sleeps);\
 	static_cast<void>(ppu.test_stopped());\
 	ppu.current_function = old_f;\
 	ppu.cia += 4;\
@@ -300,3 +308,75 @@ template<typename T, T Func>
 u32 ppu_function_manager::registered<T, Func>::index = 0;
 
 #define FIND_FUNC(func) ppu_function_manager::get_index<decltype(&func), &func>()
+
+// Accumulated call stats of a single lv2 syscall or HLE function (times in nanoseconds)
+struct ppu_call_stat_summary
+{
+	std::string name;
+	u64 calls;
+	u64 blocked; // Calls during which the thread was put to sleep
+	u64 total;
+	u64 max;
+};
+
+// Per-thread call counters of lv2 syscalls and HLE functions, updated by the owner thread without locking.
+// Syscalls are always counted, call times and HLE functions are only recorded with core.ppu_call_stats.
+class ppu_call_stats
+{
+	struct entry
+	{
+		u64 calls;
+		u64 blocked;
+		u64 ticks;
+		u64 max;
+	};
+
+	const u32 m_size;
+	std::unique_ptr<entry[]> m_data;
+
+public:
+	// Syscalls are indexed by their number, HLE functions by their ppu_function_manager index after them
+	static constexpr u32 hle_base = 1024;
+
+	explicit ppu_call_stats(bool timing) noexcept;
+
+	ppu_call_stats(const ppu_call_stats&) = delete;
+
+	ppu_call_stats& operator=(const ppu_call_stats&) = delete;
+
+	~ppu_call_stats();
+
+	// Get start timestamp, 0 if call times are not recorded
+	u64 start() const noexcept
+	{
+		return m_size > hle_base ? utils::get_tsc() : 0;
+	}
+
+	void push(u32 index, u64 start, bool blocked) noexcept
+	{
+		if (index >= m_size) [[unlikely]]
+		{
+			return;
+		}
+
+		entry& e = m_data[index];
+		e.calls++;
+		e.blocked += blocked;
+
+		if (start)
+		{
+			const u64 ticks = utils::get_tsc() - start;
+			e.ticks += ticks;
+			e.max = std::max(e.max, ticks);
+		}
+	}
+
+	// Sum stats of all threads (including finished ones), sorted by total time and call count
+	static std::vector<ppu_call_stat_summary> query(bool syscalls_only = false) noexcept;
+
+	// Make a text table of the stats
+	static std::string format(const std::vector<ppu_call_stat_summary>& stats);
+
+	// Print the table of all stats and clear the stats of finished threads
+	static void report() noexcept;
+};
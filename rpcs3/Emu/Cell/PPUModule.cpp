@@ -24,6 +24,7 @@
 #include <set>
 #include <algorithm>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 LOG_CHANNEL(ppu_loader);
 
@@ -830,7 +831,7 @@ void try_spawn_ppu_if_exclusive_program(const ppu_module& m)
 	}
 }
 
-std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object& elf, const std::string& path)
+std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object& elf, const std::string& path, std::function<void()>* analysis)
 {
 	if (elf != elf_error::ok)
 	{
@@ -1155,6 +1156,17 @@ std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object& elf, const std::stri
 		ppu_check_patch_spu_images(seg);
 	}
 
+	if (analysis)
+	{
+		// Let the caller run it, possibly in parallel with other modules
+		*analysis = [prx = prx.get(), toc, end, applied = std::move(applied)]()
+		{
+			prx->analyse(toc, 0, end, applied);
+		};
+
+		return prx;
+	}
+
 	prx->analyse(toc, 0, end, applied);
 
 	try_spawn_ppu_if_exclusive_program(*prx);
@@ -1546,6 +1558,9 @@ bool ppu_load_exec(const ppu_exec_object& elf)
 	// Module list to load at startup
 	std::set<std::string> load_libs;
 
+	// Loaded modules with deferred analysis
+	std::vector<std::pair<std::shared_ptr<lv2_prx>, std::function<void()>>> lib_analysis;
+
 	if (g_cfg.core.libraries_control.get_set().count("liblv2.sprx:lle") || !g_cfg.core.libraries_control.get_set().count("liblv2.sprx:hle"))
 	{
 		// Will load libsysmodule.sprx internally
@@ -1585,17 +1600,11 @@ bool ppu_load_exec(const ppu_exec_object& elf)
 			{
 				ppu_loader.warning("Loading library: %s", name);
 
-				auto prx = ppu_load_prx(obj, lle_dir + name);
+				std::function<void()> analysis;
 
-				if (prx->funcs.empty())
-				{
-					ppu_loader.fatal("Module %s has no functions!", name);
-				}
-				else
-				{
-					// TODO: fix arguments
-					prx->validate(prx->funcs[0].addr);
-				}
+				auto prx = ppu_load_prx(obj, lle_dir + name, &analysis);
+
+				lib_analysis.emplace_back(prx, std::move(analysis));
 
 				if (name == "liblv2.sprx")
 				{
@@ -1618,12 +1627,48 @@ bool ppu_load_exec(const ppu_exec_object& elf)
 	_main.name.clear();
 	_main.path = vfs::get(Emu.argv[0]);
 
-	// Analyse executable (TODO)
-	_main.analyse(0, static_cast<u32>(elf.header.e_entry), end, applied);
+	// Analyse executable and libraries in parallel, all of them are loaded and linked at this point
+	{
+		atomic_t<usz> next = 0;
+
+		auto analyse = [&]()
+		{
+			for (usz i = next++; i <= lib_analysis.size(); i = next++)
+			{
+				if (i == 0)
+				{
+					// Analyse executable (TODO)
+					_main.analyse(0, static_cast<u32>(elf.header.e_entry), end, applied);
+				}
+				else
+				{
+					lib_analysis[i - 1].second();
+				}
+			}
+		};
+
+		named_thread_group workers("PPU Analyser ", std::min<u32>(utils::get_thread_count() - 1, ::size32(lib_analysis)), analyse);
+
+		analyse();
+		workers.join();
+	}
 
 	// Validate analyser results (not required)
 	_main.validate(0);
 
+	for (const auto& [prx, _] : lib_analysis)
+	{
+		if (prx->funcs.empty())
+		{
+			ppu_loader.fatal("Module %s has no functions!", prx->name);
+		}
+		else
+		{
+			// TODO: fix arguments
+			prx->validate(prx->funcs[0].addr);
+		}
+	}
+
 	// Set SDK version
 	g_ps3_process_info.sdk_ver = sdk_version;
 
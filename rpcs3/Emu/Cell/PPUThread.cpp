@@ -67,6 +67,9 @@ const bool s_use_ssse3 = utils::has_ssse3();
 
 extern atomic_t<u64> g_watchdog_hold_ctr;
 
+// Modules compiled by PPU LLVM (statistics)
+atomic_t<u32> g_ppu_compiled_modules{0};
+
 #include "Emu/system_progress.hpp"
 
 // Should be of the same type
@@ -107,7 +110,7 @@ extern bool ppu_initialize(const ppu_module& info, bool = false);
 static void ppu_initialize2(class jit_compiler& jit, const ppu_module& module_part, const std::string& cache_path, const std::string& obj_name);
 extern std::pair<std::shared_ptr<lv2_overlay>, CellError> ppu_load_overlay(const ppu_exec_object&, const std::string& path);
 extern void ppu_unload_prx(const lv2_prx&);
-extern std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object&, const std::string&);
+extern std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object&, const std::string&, std::function<void()>* = nullptr);
 extern void ppu_execute_syscall(ppu_thread& ppu, u64 code);
 static bool ppu_break(ppu_thread& ppu, ppu_opcode_t op);
 
@@ -1111,6 +1114,7 @@ ppu_thread::ppu_thread(const ppu_thread_params& param, std::string_view name, u3
 	, joiner(detached != 0 ? ppu_join_status::detached : ppu_join_status::joinable)
 	, entry_func(param.entry)
 	, start_time(get_guest_system_time())
+	, call_stats(std::make_unique<ppu_call_stats>(g_cfg.core.ppu_call_stats.get()))
 	, ppu_tname(make_single<std::string>(name))
 {
 	gpr[1] = stack_addr + stack_size - ppu_stack_start_offset;
@@ -2130,6 +2134,117 @@ namespace
 			map.erase(found);
 		}
 	};
+
+	struct jit_core_allocator
+	{
+		const s32 thread_count = g_cfg.core.llvm_threads ? std::min<s32>(g_cfg.core.llvm_threads, limit()) : limit();
+
+		// Initialize global semaphore with the max number of threads
+		::semaphore<0x7fffffff> sem{std::max<s32>(thread_count, 1)};
+
+		static s32 limit()
+		{
+			return static_cast<s32>(utils::get_thread_count());
+		}
+	};
+
+	// Global queue of module partitions waiting for compilation, shared by all modules being initialized
+	struct jit_compile_scheduler
+	{
+		struct job
+		{
+			std::string cache_path;
+			std::string obj_name;
+			ppu_module part;
+
+			// 0 - queued, 1 - compiling, 2 - done
+			atomic_t<u32> state = 0;
+
+			// Compilation time in microseconds
+			u64 time = 0;
+		};
+
+		shared_mutex mutex;
+
+		// Queued jobs, ordered by priority class, then by partition index, then by submission
+		std::map<std::tuple<u32, u32, u64>, std::shared_ptr<job>> queue;
+
+		// Unfinished jobs by object path, the same object is never compiled twice concurrently
+		std::unordered_map<std::string, std::shared_ptr<job>> active;
+
+		u64 sequence = 0;
+
+		std::shared_ptr<job> submit(u32 priority, u32 index, const std::string& cache_path, std::string obj_name, ppu_module&& part)
+		{
+			std::lock_guard lock(mutex);
+
+			auto& found = active[cache_path + obj_name];
+
+			if (!found)
+			{
+				found = std::make_shared<job>();
+				found->cache_path = cache_path;
+				found->obj_name = std::move(obj_name);
+				found->part = std::move(part);
+				queue.emplace(std::make_tuple(priority, index, sequence++), found);
+			}
+
+			return found;
+		}
+
+		// Compile the most important queued partition of any module, return false if the queue is empty
+		bool run_one()
+		{
+			std::shared_ptr<job> next;
+			{
+				std::lock_guard lock(mutex);
+
+				if (queue.empty())
+				{
+					return false;
+				}
+
+				next = std::move(queue.begin()->second);
+				queue.erase(queue.begin());
+				next->state = 1;
+			}
+
+			if (!Emu.IsStopped())
+			{
+				// Allocate "core"
+				std::lock_guard jlock(g_fxo->get<jit_core_allocator>().sem);
+
+				ppu_log.warning("LLVM: Compiling module %s%s", next->cache_path, next->obj_name);
+
+				const auto start = steady_clock::now();
+
+				// Use another JIT instance
+				jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1 | Emulator::GetLLVMCacheFlags());
+				ppu_initialize2(jit2, next->part, next->cache_path, next->obj_name);
+
+				next->time = std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - start).count();
+
+				ppu_log.success("LLVM: Compiled module %s (%.3fs)", next->obj_name, next->time / 1e6);
+
+				g_ppu_compiled_modules++;
+			}
+
+			// Release module information
+			next->part = ppu_module{};
+
+			{
+				std::lock_guard lock(mutex);
+				active.erase(next->cache_path + next->obj_name);
+			}
+
+			next->state = 2;
+			next->state.notify_all();
+			return true;
+		}
+	};
+
+	// Compilation priority class of the modules initialized by the current thread
+	thread_local u32 g_jit_priority = 1;
 }
 #endif
 
@@ -2416,6 +2531,11 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<lv2_
 		// Set low priority
 		thread_ctrl::scoped_priority low_prio(-1);
 
+#ifdef LLVM_AVAILABLE
+		// Compile after the modules needed to boot
+		g_jit_priority = 2;
+#endif
+
 		for (usz func_i = fnext++; func_i < file_queue.size(); func_i = fnext++, g_progr_fdone++)
 		{
 			if (Emu.IsStopped())
@@ -2460,10 +2580,15 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<lv2_
 			{
 				std::unique_lock lock(sprx_mtx);
 
-				if (auto prx = ppu_load_prx(obj, path))
+				std::function<void()> analysis;
+
+				if (auto prx = ppu_load_prx(obj, path, &analysis))
 				{
 					lock.unlock();
 					obj.clear(), src.close(); // Clear decrypted file and elf object memory
+
+					// Analyse outside of the lock, concurrently with other workers
+					analysis();
 					ppu_initialize(*prx);
 					idm::remove<lv2_obj, lv2_prx>(idm::last_id());
 					lock.lock();
@@ -2566,10 +2691,22 @@ extern void ppu_initialize()
 	// If empty we have no indication for cache state, check everything
 	bool compile_fw = prx_list.empty();
 
+	// Modules needed to boot which are not compiled yet
+	std::vector<const ppu_module*> boot_queue;
+
+	if (compile_main)
+	{
+		boot_queue.emplace_back(&_main);
+	}
+
 	// Check preloaded libraries cache
 	for (auto ptr : prx_list)
 	{
-		compile_fw |= ppu_initialize(*ptr, true);
+		if (ppu_initialize(*ptr, true))
+		{
+			compile_fw = true;
+			boot_queue.emplace_back(ptr);
+		}
 	}
 
 	std::vector<std::string> dir_queue;
@@ -2588,8 +2725,27 @@ extern void ppu_initialize()
 		dir_queue.insert(std::end(dir_queue), std::begin(dirs), std::end(dirs));
 	}
 
+	atomic_t<usz> bnext = 0;
+
+	// Compile the boot modules alongside the precompilation, their partitions are scheduled first
+	named_thread_group boot_workers("PPU Boot Worker ", std::min<u32>(utils::get_thread_count(), ::size32(boot_queue)), [&]
+	{
+		for (usz i = bnext++; i < boot_queue.size(); i = bnext++)
+		{
+			if (Emu.IsStopped())
+			{
+				break;
+			}
+
+			// Not a CPU thread: only compiles the objects, linking is done below
+			ppu_initialize(*boot_queue[i]);
+		}
+	});
+
 	ppu_precompile(dir_queue, &prx_list);
 
+	boot_workers.join();
+
 	if (Emu.IsStopped())
 	{
 		return;
@@ -2620,6 +2776,57 @@ struct ppu_toc_manager
 	shared_mutex mutex;
 };
 
+// Hash everything the translation of a function depends on: relative address, size and code with relocated immediates masked
+static std::array<u8, 20> ppu_hash_function(const ppu_module& info, const ppu_function& func, u32 reloc)
+{
+	sha1_context ctx;
+	sha1_starts(&ctx);
+
+	const be_t<u32> addr = func.addr - reloc;
+	const be_t<u32> size = func.size;
+	sha1_update(&ctx, reinterpret_cast<const u8*>(&addr), sizeof(addr));
+	sha1_update(&ctx, reinterpret_cast<const u8*>(&size), sizeof(size));
+
+	// Find relevant relocations
+	auto low = std::lower_bound(info.relocs.cbegin(), info.relocs.cend(), func.addr);
+	auto high = std::lower_bound(low, info.relocs.cend(), func.addr + func.size);
+	u32 pos = func.addr;
+
+	for (; low != high; ++low)
+	{
+		// Only immediates of these types are loaded at runtime by the translator, others are compiled in
+		if (low->type < 4 || low->type > 6)
+		{
+			continue;
+		}
+
+		// Aligned relocation address
+		const u32 roff = low->addr & ~3;
+
+		if (roff < pos)
+		{
+			continue;
+		}
+
+		// Hash from pos to the beginning of the relocation
+		sha1_update(&ctx, vm::_ptr<const u8>(pos), roff - pos);
+
+		// Hash relocation type instead
+		const be_t<u32> type = low->type;
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&type), sizeof(type));
+
+		// Set the next pos
+		pos = roff + 4;
+	}
+
+	// Hash from pos to the end of the function
+	sha1_update(&ctx, vm::_ptr<const u8>(pos), func.addr + func.size - pos);
+
+	std::array<u8, 20> output;
+	sha1_finish(&ctx, output.data());
+	return output;
+}
+
 bool ppu_initialize(const ppu_module& info, bool check_only)
 {
 	if (g_cfg.core.ppu_decoder != ppu_decoder_type::llvm)
@@ -2692,6 +2899,10 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 	// Get cache path for this executable
 	std::string cache_path;
 
+	// Cache directory shared by all versions of this executable, and the suffix of their cache names
+	std::string title_cache_path;
+	std::string cache_suffix;
+
 	if (info.name.empty())
 	{
 		cache_path = info.cache;
@@ -2710,8 +2921,11 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 			cache_path += '/';
 		}
 
+		title_cache_path = cache_path;
+		cache_suffix = "-" + info.path.substr(info.path.find_last_of('/') + 1);
+
 		// Add PPU hash and filename
-		fmt::append(cache_path, "ppu-%s-%s/", fmt::base57(info.sha1), info.path.substr(info.path.find_last_of('/') + 1));
+		fmt::append(cache_path, "ppu-%s%s/", fmt::base57(info.sha1), cache_suffix);
 
 		if (!fs::create_path(cache_path))
 		{
@@ -2728,42 +2942,88 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		progr.emplace("Loading PPU modules...");
 	}
 
-	struct jit_core_allocator
-	{
-		const s32 thread_count = g_cfg.core.llvm_threads ? std::min<s32>(g_cfg.core.llvm_threads, limit()) : limit();
-
-		// Initialize global semaphore with the max number of threads
-		::semaphore<0x7fffffff> sem{std::max<s32>(thread_count, 1)};
-
-		static s32 limit()
-		{
-			return static_cast<s32>(utils::get_thread_count());
-		}
-	};
-
 	// Permanently loaded compiled PPU modules (name -> data)
 	jit_module& jit_mod = g_fxo->get<jit_module_manager>().get(cache_path + info.name);
 
 	// Compiler instance (deferred initialization)
 	std::shared_ptr<jit_compiler>& jit = jit_mod.pjit;
 
-	// Split module into fragments <= 1 MiB
+	// Split module into partitions, boundaries are derived from function contents (see below)
 	usz fpos = 0;
 
+	// Partition size limits in bytes of PPU code
+	constexpr usz part_min_size = 16 * 1024;
+	constexpr usz part_max_size = 256 * 1024;
+
+	// A function whose hash has these bits clear ends a partition (about every 128 functions)
+	constexpr u8 part_boundary_mask = 0x7f;
+
 	// Difference between function name and current location
 	const u32 reloc = info.relocs.empty() ? 0 : info.segs.at(0).addr;
 
-	// Info sent to threads
-	std::vector<std::pair<std::string, ppu_module>> workload;
+	// Partitions submitted to the global compilation queue
+	std::vector<std::shared_ptr<jit_compile_scheduler::job>> workload;
+
+	// Boot needs the main executable first, then the loaded libraries, precompilation comes last
+	const u32 priority = &info == &g_fxo->get<ppu_module>() ? 0 : g_jit_priority;
 
 	// Info to load to main JIT instance (true - compiled)
 	std::vector<std::pair<std::string, bool>> link_workload;
 
-	// Sync variable to acquire workloads
-	atomic_t<u32> work_cv = 0;
-
 	bool compiled_new = false;
 
+	// Per-function content hashes of the module
+	std::vector<std::array<u8, 20>> func_hashes;
+
+	// Cache directories of other versions of this executable (scanned on the first missing object)
+	std::optional<std::vector<std::string>> other_caches;
+
+	// Objects are named by content, so an identical object compiled for another version can be reused
+	auto import_object = [&](const std::string& obj_name) -> bool
+	{
+		if (title_cache_path.empty())
+		{
+			return false;
+		}
+
+		if (!other_caches)
+		{
+			other_caches.emplace();
+
+			for (auto&& entry : fs::dir(title_cache_path))
+			{
+				if (entry.is_directory && entry.name.starts_with("ppu-") && entry.name.ends_with(cache_suffix) && title_cache_path + entry.name + '/' != cache_path)
+				{
+					other_caches->emplace_back(title_cache_path + entry.name + '/');
+				}
+			}
+		}
+
+		for (const std::string& dir : *other_caches)
+		{
+			if (jit_compiler::copy(dir + obj_name, cache_path + obj_name) && jit_compiler::check(cache_path + obj_name))
+			{
+				ppu_log.success("LLVM: Reused module %s from %s", obj_name, dir);
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	if (!jit_mod.init)
+	{
+		func_hashes.resize(info.funcs.size());
+
+		for (usz i = 0; i < info.funcs.size(); i++)
+		{
+			if (info.funcs[i].size)
+			{
+				func_hashes[i] = ppu_hash_function(info, info.funcs[i], reloc);
+			}
+		}
+	}
+
 	while (!jit_mod.init && fpos < info.funcs.size())
 	{
 		// Initialize compiler instance
@@ -2775,11 +3035,17 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		// Copy module information (TODO: optimize)
 		ppu_module part;
 		part.copy_part(info);
-		part.funcs.reserve(16000);
+		part.funcs.reserve(1024);
+
+		// Partition hash is computed from the hashes of its functions
+		sha1_context ctx;
+		u8 output[20];
+		sha1_starts(&ctx);
 
 		// Overall block size in bytes
 		usz bsize = 0;
-		usz bcount = 0;
+
+		bool has_dcbz = false;
 
 		while (fpos < info.funcs.size())
 		{
@@ -2791,12 +3057,9 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				continue;
 			}
 
-			if (bsize + func.size > 100 * 1024 && bsize)
+			if (bsize + func.size > part_max_size && bsize)
 			{
-				if (bcount >= 1000)
-				{
-					break;
-				}
+				break;
 			}
 
 			// Copy block or function entry
@@ -2810,108 +3073,37 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				entry.blocks.emplace(func.addr, func.size);
 			}
 
-			bsize += func.size;
-
-			fpos++;
-			bcount++;
-		}
-
-		// Compute module hash to generate (hopefully) unique object name
-		std::string obj_name;
-		{
-			sha1_context ctx;
-			u8 output[20];
-			sha1_starts(&ctx);
+			const auto& func_hash = func_hashes[fpos];
+			sha1_update(&ctx, func_hash.data(), func_hash.size());
 
-			int has_dcbz = !!g_cfg.core.accurate_cache_line_stores;
-
-			for (const auto& func : part.funcs)
+			if (!has_dcbz && g_cfg.core.accurate_cache_line_stores)
 			{
-				if (func.size == 0)
+				for (u32 i = func.addr, end = func.addr + func.size - 1; i <= end; i += 4)
 				{
-					continue;
-				}
-
-				const be_t<u32> addr = func.addr - reloc;
-				const be_t<u32> size = func.size;
-				sha1_update(&ctx, reinterpret_cast<const u8*>(&addr), sizeof(addr));
-				sha1_update(&ctx, reinterpret_cast<const u8*>(&size), sizeof(size));
-
-				for (const auto& block : func.blocks)
-				{
-					if (block.second == 0 || reloc)
-					{
-						continue;
-					}
-
-					// Find relevant relocations
-					auto low = std::lower_bound(part.relocs.cbegin(), part.relocs.cend(), block.first);
-					auto high = std::lower_bound(low, part.relocs.cend(), block.first + block.second);
-					auto addr = block.first;
-
-					for (; low != high; ++low)
+					if (g_ppu_itype.decode(vm::read32(i)) == ppu_itype::DCBZ)
 					{
-						// Aligned relocation address
-						const u32 roff = low->addr & ~3;
-
-						if (roff > addr)
-						{
-							// Hash from addr to the beginning of the relocation
-							sha1_update(&ctx, vm::_ptr<const u8>(addr), roff - addr);
-						}
-
-						// Hash relocation type instead
-						const be_t<u32> type = low->type;
-						sha1_update(&ctx, reinterpret_cast<const u8*>(&type), sizeof(type));
-
-						// Set the next addr
-						addr = roff + 4;
-					}
-
-					if (has_dcbz == 1)
-					{
-						for (u32 i = addr, end = block.second + block.first - 1; i <= end; i += 4)
-						{
-							if (g_ppu_itype.decode(vm::read32(i)) == ppu_itype::DCBZ)
-							{
-								has_dcbz = 2;
-								break;
-							}
-						}
+						has_dcbz = true;
+						break;
 					}
-
-					// Hash from addr to the end of the block
-					sha1_update(&ctx, vm::_ptr<const u8>(addr), block.second - (addr - block.first));
-				}
-
-				if (reloc)
-				{
-					continue;
 				}
+			}
 
-				if (has_dcbz == 1)
-				{
-					for (u32 i = func.addr, end = func.addr + func.size - 1; i <= end; i += 4)
-					{
-						if (g_ppu_itype.decode(vm::read32(i)) == ppu_itype::DCBZ)
-						{
-							has_dcbz = 2;
-							break;
-						}
-					}
-				}
+			bsize += func.size;
 
-				sha1_update(&ctx, vm::_ptr<const u8>(func.addr), func.size);
-			}
+			fpos++;
 
-			if (false)
+			// Content-defined boundary: it doesn't move when code is inserted or patched in other partitions
+			if (bsize >= part_min_size && !(func_hash[0] & part_boundary_mask))
 			{
-				const be_t<u64> forced_upd = 3;
-				sha1_update(&ctx, reinterpret_cast<const u8*>(&forced_upd), sizeof(forced_upd));
+				break;
 			}
+		}
 
-			sha1_finish(&ctx, output);
+		sha1_finish(&ctx, output);
 
+		// Generate (hopefully) unique object name
+		std::string obj_name;
+		{
 			// Settings: should be populated by settings which affect codegen (TODO)
 			enum class ppu_settings : u32
 			{
@@ -2937,7 +3129,7 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				settings += ppu_settings::accurate_ppu_vector_nan;
 			if (g_cfg.core.llvm_ppu_jm_handling)
 				settings += ppu_settings::java_mode_handling;
-			if (has_dcbz == 2)
+			if (has_dcbz)
 				settings += ppu_settings::accurate_cache_line_stores;
 			if (g_cfg.core.ppu_128_reservations_loop_max_length)
 				settings += ppu_settings::reservations_128_byte;
@@ -2945,7 +3137,7 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 				settings += ppu_settings::greedy_mode;
 
 			// Write version, hash, CPU, settings
-			fmt::append(obj_name, "v4-kusa-%s-%s-%s.obj", fmt::base57(output, 16), fmt::base57(settings), jit_compiler::cpu(g_cfg.core.llvm_cpu));
+			fmt::append(obj_name, "v5-kusa-%s-%s-%s.obj", fmt::base57(output, 16), fmt::base57(settings), jit_compiler::cpu(g_cfg.core.llvm_cpu));
 		}
 
 		if (Emu.IsStopped())
@@ -2962,7 +3154,7 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		}
 
 		// Check object file
-		if (jit_compiler::check(cache_path + obj_name))
+		if (jit_compiler::check(cache_path + obj_name) || import_object(obj_name))
 		{
 			if (!jit && !check_only)
 			{
@@ -2983,8 +3175,8 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		// Adjust information (is_compiled)
 		link_workload.back().second = true;
 
-		// Fill workload list for compilation
-		workload.emplace_back(std::move(obj_name), std::move(part));
+		// Queue the partition for compilation
+		workload.emplace_back(g_fxo->get<jit_compile_scheduler>().submit(priority, ::size32(link_workload) - 1, cache_path, std::move(obj_name), std::move(part)));
 	}
 
 	if (check_only)
@@ -3014,38 +3206,50 @@ bool ppu_initialize(const ppu_module& info, bool check_only)
 		// Prevent watchdog thread from terminating
 		g_watchdog_hold_ctr++;
 
+		const auto start_time = steady_clock::now();
+
+		auto& sched = g_fxo->get<jit_compile_scheduler>();
+
+		// Workers compile partitions of any module (by priority) while partitions of this module are still queued
 		named_thread_group threads(fmt::format("PPUW.%u.", ++g_fxo->get<thread_index_allocator>().index), thread_count, [&]()
 		{
 			// Set low priority
 			thread_ctrl::scoped_priority low_prio(-1);
 
-			for (u32 i = work_cv++; i < workload.size(); i = work_cv++, g_progr_pdone++)
+			while (std::any_of(workload.begin(), workload.end(), [](const auto& job) { return job->state == 0; }) && sched.run_one())
 			{
-				if (Emu.IsStopped())
-				{
-					continue;
-				}
-
-				// Keep allocating workload
-				const auto& [obj_name, part] = std::as_const(workload)[i];
+			}
+		});
 
-				// Allocate "core"
-				std::lock_guard jlock(g_fxo->get<jit_core_allocator>().sem);
+		threads.join();
 
-				ppu_log.warning("LLVM: Compiling module %s%s", cache_path, obj_name);
+		// Wait for the partitions taken by workers of other modules
+		const jit_compile_scheduler::job* longest = nullptr;
 
-				// Use another JIT instance
-				jit_compiler jit2({}, g_cfg.core.llvm_cpu, 0x1);
-				ppu_initialize2(jit2, part, cache_path, obj_name);
+		for (const auto& job : workload)
+		{
+			for (u32 state; (state = job->state) != 2;)
+			{
+				job->state.wait(state);
+			}
 
-				ppu_log.success("LLVM: Compiled module %s", obj_name);
+			if (!longest || job->time > longest->time)
+			{
+				longest = job.get();
 			}
-		});
 
-		threads.join();
+			g_progr_pdone++;
+		}
 
 		g_watchdog_hold_ctr--;
 
+		if (longest && !Emu.IsStopped())
+		{
+			// The longest partition bounds the compilation time of the module
+			const u64 usec = std::chrono::duration_cast<std::chrono::microseconds>(steady_clock::now() - start_time).count();
+			ppu_log.notice("LLVM: Compiled %u partitions of %s in %.3fs, longest: %s (%.3fs)", workload.size(), cache_path, usec / 1e6, longest->obj_name, longest->time / 1e6);
+		}
+
 		if (Emu.IsStopped() || !get_current_cpu_thread())
 		{
 			return compiled_new;
@@ -110,6 +110,8 @@ struct cmd64
 	}
 };
 
+class ppu_call_stats;
+
 class ppu_thread : public cpu_thread
 {
 public:
@@ -268,6 +270,8 @@ public:
 	u64 syscall_args[8]{0}; // Last syscall arguments stored
 	const char* current_function{}; // Current function name for diagnosis, optimized for speed.
 	const char* last_function{}; // Sticky copy of current_function, is not cleared on function return
+	u32 sleep_count = 0; // Incremented every time lv2 puts the thread to sleep
+	std::unique_ptr<ppu_call_stats> call_stats; // Syscall and HLE function call counters
 
 	// Thread name
 	atomic_ptr<std::string> ppu_tname;
@@ -9,6 +9,7 @@
 #include "Utilities/StrUtil.h"
 #include "Utilities/JIT.h"
 #include "util/init_mutex.hpp"
+#include "xxhash.h"
 
 #include "SPUThread.h"
 #include "SPUAnalyser.h"
@@ -32,6 +33,9 @@ const spu_decoder<spu_iflag> s_spu_iflag;
 extern const spu_decoder<spu_interpreter_precise> g_spu_interpreter_precise{};
 extern const spu_decoder<spu_interpreter_fast> g_spu_interpreter_fast;
 
+// Programs built from the SPU cache (statistics)
+atomic_t<u32> g_spu_cache_built_programs{0};
+
 // Move 4 args for calling native function from a GHC calling convention function
 static u8* move_args_ghc_to_native(u8* raw)
 {
@@ -280,41 +284,311 @@ DECLARE(spu_runtime::g_interpreter_table) = {};
 
 DECLARE(spu_runtime::g_interpreter) = nullptr;
 
+// SPU cache file layout (v2):
+// header, entries (header + program data), table of contents (entry offsets), footer.
+// The table of contents is only written on clean shutdown and stripped on open,
+// so new entries are always appended right after the last valid entry.
+struct spu_cache_header
+{
+	nse_t<u64> magic;
+	be_t<u32> version;
+	be_t<u32> reserved;
+};
+
+struct spu_cache_entry_header
+{
+	be_t<u32> size; // Program size in words
+	be_t<u32> addr; // Entry point
+	be_t<u64> hash; // XXH64 of program data
+};
+
+struct spu_cache_footer
+{
+	be_t<u64> toc_pos;
+	be_t<u64> toc_count;
+	be_t<u64> toc_hash; // XXH64 of the table of contents
+	nse_t<u64> magic;
+};
+
+static constexpr u64 c_spu_cache_magic = "RPCS3SPU"_u64;
+static constexpr u64 c_spu_cache_toc_magic = "SPUTOC\0\0"_u64;
+static constexpr u32 c_spu_cache_version = 2;
+
 spu_cache::spu_cache(const std::string& loc)
-	: m_file(loc, fs::read + fs::write + fs::create + fs::append)
+	: m_file(loc, fs::read + fs::write + fs::create)
+{
+	if (!m_file)
+	{
+		return;
+	}
+
+	const u64 file_size = m_file.size();
+
+	spu_cache_header header{};
+
+	if (file_size < sizeof(header) || !m_file.read(header) || header.magic != c_spu_cache_magic || header.version != c_spu_cache_version)
+	{
+		if (file_size)
+		{
+			spu_log.error("SPU Cache: Unrecognized file format, discarding: %s", loc);
+		}
+
+		header.magic = c_spu_cache_magic;
+		header.version = c_spu_cache_version;
+		header.reserved = 0;
+
+		m_file.trunc(0);
+		m_file.seek(0);
+		m_file.write(header);
+		m_data_end = sizeof(header);
+	}
+	else if (spu_cache_footer footer{}; file_size >= sizeof(header) + sizeof(footer) && m_file.seek(file_size - sizeof(footer)) != umax && m_file.read(footer) &&
+		footer.magic == c_spu_cache_toc_magic && footer.toc_pos >= sizeof(header) && footer.toc_pos <= file_size - sizeof(footer) &&
+		(file_size - sizeof(footer) - footer.toc_pos) % sizeof(u64) == 0 && (file_size - sizeof(footer) - footer.toc_pos) / sizeof(u64) == footer.toc_count)
+	{
+		// Fast path: load the table of contents written on the last clean shutdown
+		std::vector<be_t<u64>> toc(footer.toc_count);
+
+		m_file.seek(footer.toc_pos);
+
+		if (m_file.read(toc) && XXH64(toc.data(), toc.size() * sizeof(u64), 0) == footer.toc_hash)
+		{
+			m_toc.reserve(toc.size());
+
+			for (u64 pos : toc)
+			{
+				if (pos < sizeof(header) || pos + sizeof(spu_cache_entry_header) > footer.toc_pos)
+				{
+					break;
+				}
+
+				m_toc.push_back(pos);
+			}
+		}
+
+		if (m_toc.size() == toc.size())
+		{
+			m_data_end = footer.toc_pos;
+		}
+		else
+		{
+			spu_log.error("SPU Cache: Table of contents is broken: %s", loc);
+			m_toc.clear();
+		}
+	}
+
+	if (!m_data_end)
+	{
+		// Slow path: validate every entry, stop at the first broken one
+		m_view = fs::file_view(m_file);
+
+		if (m_view.size() != file_size)
+		{
+			spu_log.error("SPU Cache: Failed to map file: %s (%s)", loc, fs::g_tls_error);
+			m_file.close();
+			return;
+		}
+
+		u64 pos = sizeof(header);
+
+		while (pos + sizeof(spu_cache_entry_header) <= m_view.size())
+		{
+			spu_cache_entry_header entry;
+			std::memcpy(&entry, m_view.data() + pos, sizeof(entry));
+
+			const u64 data_size = u64{entry.size} * 4;
+
+			if (!entry.size || data_size > m_view.size() - pos - sizeof(entry) || XXH64(m_view.data() + pos + sizeof(entry), data_size, 0) != entry.hash)
+			{
+				break;
+			}
+
+			m_toc.push_back(pos);
+			pos += sizeof(entry) + data_size;
+		}
+
+		m_view.close();
+		m_data_end = pos;
+
+		if (pos != file_size)
+		{
+			spu_log.warning("SPU Cache: Truncated or broken file (0x%x/0x%x bytes valid), repairing: %s", pos, file_size, loc);
+		}
+	}
+
+	// Strip the table of contents or the broken tail
+	if (m_data_end != file_size && !m_file.trunc(m_data_end))
+	{
+		spu_log.error("SPU Cache: Failed to truncate file: %s (%s)", loc, fs::g_tls_error);
+		m_file.close();
+		m_toc.clear();
+		return;
+	}
+
+	m_view = fs::file_view(m_file, m_data_end);
+
+	if (!m_toc.empty() && m_view.size() != m_data_end)
+	{
+		spu_log.error("SPU Cache: Failed to map file: %s (%s)", loc, fs::g_tls_error);
+		m_toc.clear();
+	}
+
+	// Reopen for appending only
+	m_file.open(loc, fs::read + fs::write + fs::append);
+}
+
+spu_cache& spu_cache::operator=(spu_cache&& other) noexcept
 {
+	if (this != &other)
+	{
+		finalize();
+		m_file = std::move(other.m_file);
+		m_view = std::move(other.m_view);
+		m_toc = std::move(other.m_toc);
+		m_data_end = other.m_data_end;
+	}
+
+	return *this;
 }
 
 spu_cache::~spu_cache()
 {
+	finalize();
 }
 
-std::deque<spu_program> spu_cache::get()
+void spu_cache::finalize()
 {
-	std::deque<spu_program> result;
+	if (!m_file)
+	{
+		return;
+	}
+
+	m_view.close();
+
+	// Index the entries appended during this session
+	const u64 file_size = m_file.size();
+
+	std::vector<be_t<u64>> toc(m_toc.begin(), m_toc.end());
 
+	for (u64 pos = m_data_end; pos + sizeof(spu_cache_entry_header) <= file_size;)
+	{
+		spu_cache_entry_header entry;
+
+		if (m_file.seek(pos) != pos || !m_file.read(entry) || !entry.size || pos + sizeof(entry) + u64{entry.size} * 4 > file_size)
+		{
+			break;
+		}
+
+		toc.push_back(pos);
+		pos += sizeof(entry) + u64{entry.size} * 4;
+	}
+
+	spu_cache_footer footer;
+	footer.toc_pos = file_size;
+	footer.toc_count = toc.size();
+	footer.toc_hash = XXH64(toc.data(), toc.size() * sizeof(u64), 0);
+	footer.magic = c_spu_cache_toc_magic;
+
+	const fs::iovec_clone gather[2]
+	{
+		{toc.data(), toc.size() * sizeof(u64)},
+		{&footer, sizeof(footer)}
+	};
+
+	m_file.write_gather(gather, 2);
+	m_file.close();
+	m_toc.clear();
+}
+
+bool spu_cache::get(usz index, spu_program& out) const
+{
+	const u64 pos = m_toc[index];
+
+	spu_cache_entry_header entry;
+
+	if (pos + sizeof(entry) > m_view.size())
+	{
+		return false;
+	}
+
+	std::memcpy(&entry, m_view.data() + pos, sizeof(entry));
+
+	const u64 data_size = u64{entry.size} * 4;
+
+	if (!entry.size || data_size > m_view.size() - pos - sizeof(entry))
+	{
+		return false;
+	}
+
+	const u8* data = m_view.data() + pos + sizeof(entry);
+
+	if (XXH64(data, data_size, 0) != entry.hash)
+	{
+		return false;
+	}
+
+	out.entry_point = entry.addr;
+	out.lower_bound = entry.addr;
+	out.data.resize(entry.size);
+	std::memcpy(out.data.data(), data, data_size);
+	return true;
+}
+
+void spu_cache::add(const spu_program& func)
+{
 	if (!m_file)
 	{
-		return result;
+		return;
 	}
 
-	m_file.seek(0);
+	spu_cache_entry_header entry;
+	entry.size = ::size32(func.data);
+	entry.addr = func.entry_point;
+	entry.hash = XXH64(func.data.data(), func.data.size() * 4, 0);
+
+	const fs::iovec_clone gather[2]
+	{
+		{&entry, sizeof(entry)},
+		{func.data.data(), func.data.size() * 4}
+	};
+
+	// Append data
+	m_file.write_gather(gather, 2);
+}
+
+// Import entries from the old cache format (v1)
+static void spu_cache_import_v1(const std::string& from, const std::string& loc)
+{
+	fs::file file(from);
+
+	if (!file)
+	{
+		return;
+	}
+
+	spu_cache to(loc);
+
+	if (!to)
+	{
+		return;
+	}
+
+	usz count = 0;
 
-	// TODO: signal truncated or otherwise broken file
 	while (true)
 	{
 		be_t<u32> size;
 		be_t<u32> addr;
 		std::vector<u32> func;
 
-		if (!m_file.read(size) || !m_file.read(addr))
+		if (!file.read(size) || !file.read(addr))
 		{
 			break;
 		}
 
 		func.resize(size);
 
-		if (m_file.read(func.data(), func.size() * 4) != func.size() * 4)
+		if (file.read(func.data(), func.size() * 4) != func.size() * 4)
 		{
 			break;
 		}
@@ -329,31 +603,14 @@ std::deque<spu_program> spu_cache::get()
 		res.entry_point = addr;
 		res.lower_bound = addr;
 		res.data = std::move(func);
-		result.emplace_front(std::move(res));
-	}
-
-	return result;
-}
-
-void spu_cache::add(const spu_program& func)
-{
-	if (!m_file)
-	{
-		return;
+		to.add(res);
+		count++;
 	}
 
-	be_t<u32> size = ::size32(func.data);
-	be_t<u32> addr = func.entry_point;
+	file.close();
 
-	const fs::iovec_clone gather[3]
-	{
-		{&size, sizeof(size)},
-		{&addr, sizeof(addr)},
-		{func.data.data(), func.data.size() * 4}
-	};
-
-	// Append data
-	m_file.write_gather(gather, 3);
+	spu_log.success("SPU Cache: Imported %u programs from %s", count, from);
+	fs::remove_file(from);
 }
 
 void spu_cache::initialize()
@@ -376,7 +633,12 @@ void spu_cache::initialize()
 	}
 
 	// SPU cache file (version + block size type)
-	const std::string loc = ppu_cache + "spu-" + fmt::to_lower(g_cfg.core.spu_block_size.to_string()) + "-v1-tane.dat";
+	const std::string loc = ppu_cache + "spu-" + fmt::to_lower(g_cfg.core.spu_block_size.to_string()) + "-v2-tane.dat";
+
+	if (const std::string old_loc = ppu_cache + "spu-" + fmt::to_lower(g_cfg.core.spu_block_size.to_string()) + "-v1-tane.dat"; fs::is_file(old_loc))
+	{
+		spu_cache_import_v1(old_loc, loc);
+	}
 
 	spu_cache cache(loc);
 
@@ -386,8 +648,8 @@ void spu_cache::initialize()
 		return;
 	}
 
-	// Read cache
-	auto func_list = cache.get();
+	// Only the index is loaded here, programs are read from the mapping by the workers
+	const usz func_count = cache.size();
 	atomic_t<usz> fnext{};
 	atomic_t<u8> fail_flag{0};
 
@@ -422,7 +684,7 @@ void spu_cache::initialize()
 		// Initialize progress dialog (wait for previous progress done)
 		g_progr_ptotal.wait<atomic_wait::op_ne>(0);
 
-		g_progr_ptotal += ::size32(func_list);
+		g_progr_ptotal += ::narrow<u32>(func_count);
 		progr.emplace("Building SPU cache...");
 
 		worker_count = Emulator::GetMaxThreads();
@@ -454,15 +716,23 @@ void spu_cache::initialize()
 		std::vector<be_t<u32>> ls(0x10000);
 
 		// Build functions
-		for (usz func_i = fnext++; func_i < func_list.size(); func_i = fnext++, g_progr_pdone++)
+		for (usz func_i = fnext++; func_i < func_count; func_i = fnext++, g_progr_pdone++)
 		{
-			const spu_program& func = std::as_const(func_list)[func_i];
-
 			if (Emu.IsStopped() || fail_flag)
 			{
 				continue;
 			}
 
+			// Build the most recent entries first
+			spu_program func;
+
+			if (!cache.get(func_count - 1 - func_i, func))
+			{
+				spu_log.error("SPU Cache: Broken entry %u", func_count - 1 - func_i);
+				result++;
+				continue;
+			}
+
 			// Get data start
 			const u32 start = func.lower_bound;
 			const u32 size0 = ::size32(func.data);
@@ -507,6 +777,10 @@ void spu_cache::initialize()
 				// Likely, out of JIT memory. Signal to prevent further building.
 				fail_flag |= 1;
 			}
+			else
+			{
+				g_spu_cache_built_programs++;
+			}
 
 			// Clear fake LS
 			std::memset(ls.data() + start / 4, 0, 4 * (size0 - 1));
@@ -535,9 +809,9 @@ void spu_cache::initialize()
 		return;
 	}
 
-	if ((g_cfg.core.spu_decoder == spu_decoder_type::asmjit || g_cfg.core.spu_decoder == spu_decoder_type::llvm) && !func_list.empty())
+	if ((g_cfg.core.spu_decoder == spu_decoder_type::asmjit || g_cfg.core.spu_decoder == spu_decoder_type::llvm) && func_count)
 	{
-		spu_log.success("SPU Runtime: Built %u functions.", func_list.size());
+		spu_log.success("SPU Runtime: Built %u functions.", func_count);
 	}
 
 	// Initialize global cache instance
@@ -3238,7 +3512,7 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out)
 class spu_llvm_recompiler : public spu_recompiler_base, public cpu_translator
 {
 	// JIT Instance
-	jit_compiler m_jit{{}, jit_compiler::cpu(g_cfg.core.llvm_cpu)};
+	jit_compiler m_jit{{}, jit_compiler::cpu(g_cfg.core.llvm_cpu), Emulator::GetLLVMCacheFlags()};
 
 	// Interpreter table size power
 	const u8 m_interp_magn;
@@ -15,6 +15,18 @@ class spu_cache
 {
 	fs::file m_file;
 
+	// Read-only mapping of the entries present on open
+	fs::file_view m_view;
+
+	// Offsets of the valid entries present on open (file order)
+	std::vector<u64> m_toc;
+
+	// End of the entries covered by m_toc
+	u64 m_data_end = 0;
+
+	// Write the table of contents for the next session
+	void finalize();
+
 public:
 	spu_cache() = default;
 
@@ -22,7 +34,7 @@ public:
 
 	spu_cache(spu_cache&&) noexcept = default;
 
-	spu_cache& operator=(spu_cache&&) noexcept = default;
+	spu_cache& operator=(spu_cache&&) noexcept;
 
 	~spu_cache();
 
@@ -31,7 +43,14 @@ public:
 		return m_file.operator bool();
 	}
 
-	std::deque<struct spu_program> get();
+	// Number of valid entries found on open
+	usz size() const
+	{
+		return m_toc.size();
+	}
+
+	// Load the entry from the mapping (thread-safe), returns false if it's broken
+	bool get(usz index, struct spu_program& out) const;
 
 	void add(const struct spu_program& func);
 
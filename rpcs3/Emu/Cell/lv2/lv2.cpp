@@ -1015,27 +1015,21 @@ class ppu_syscall_usage
 	std::string m_stats;
 
 public:
-	// Public info collection buffers
-	atomic_t<u64> stat[1024]{};
-
 	void print_stats() noexcept
 	{
-		std::multimap<u64, u64, std::greater<u64>> usage;
+		// Counted per thread (ppu_call_stats)
+		std::multimap<u64, std::string, std::greater<u64>> usage;
 
-		for (u32 i = 0; i < 1024; i++)
+		for (auto& stat : ppu_call_stats::query(true))
 		{
-			if (u64 v = stat[i])
-			{
-				// Only add syscalls with non-zero usage counter
-				usage.emplace(v, i);
-			}
+			usage.emplace(stat.calls, std::move(stat.name));
 		}
 
 		m_stats.clear();
 
 		for (auto&& pair : usage)
 		{
-			fmt::append(m_stats, u8"\n\t⁂ %s [%u]", ppu_get_syscall_name(pair.second), pair.first);
+			fmt::append(m_stats, u8"\n\t⁂ %s [%u]", pair.second, pair.first);
 		}
 
 		ppu_log.notice("PPU Syscall Usage Stats: %s", m_stats);
@@ -1073,11 +1067,15 @@ extern void ppu_execute_syscall(ppu_thread& ppu, u64 code)
 
 	if (code < g_ppu_syscall_table.size())
 	{
-		g_fxo->get<named_thread<ppu_syscall_usage>>().stat[code]++;
+		// Only registers the usage thread in g_fxo (no-op)
+		static_cast<void>(g_fxo->get<named_thread<ppu_syscall_usage>>());
 
 		if (const auto func = g_ppu_syscall_table[code].first)
 		{
+			const u64 stat_start = ppu.call_stats->start();
+			const u32 stat_sleeps = ppu.sleep_count;
 			func(ppu);
+			ppu.call_stats->push(static_cast<u32>(code), stat_start, ppu.sleep_count != stat_sleeps);
 			ppu_log.trace("Syscall '%s' (%llu) finished, r3=0x%llx", ppu_syscall_code(code), code, ppu.gpr[3]);
 			return;
 		}
@@ -1106,6 +1104,74 @@ std::string ppu_get_syscall_name(u64 code)
 	return fmt::format("syscall_%u", code);
 }
 
+void lv2_sleep_queue::emplace_back(cpu_thread* cpu)
+{
+	auto& node = cpu->sleep_node;
+
+	// Must not be linked in another queue
+	ensure(!node.owner);
+	AUDIT(!m_mutex.is_free());
+
+	// Values above 3071 are not distinguished by the scheduler
+	node.prio = cpu->id_type() == 1 ? std::min<s32>(static_cast<ppu_thread*>(cpu)->prio, 3071) : 0;
+
+	node.owner = this;
+
+	// Arrival order
+	node.prev = m_tail;
+	(m_tail ? m_tail->sleep_node.next : m_head) = cpu;
+	m_tail = cpu;
+
+	link_priority(cpu);
+
+	m_size++;
+}
+
+void lv2_sleep_queue::link_priority(cpu_thread* cpu) noexcept
+{
+	auto& node = cpu->sleep_node;
+
+	cpu_thread* after = m_prio_tail;
+
+	while (after && after->sleep_node.prio > node.prio)
+	{
+		after = after->sleep_node.prio_prev;
+	}
+
+	node.prio_prev = after;
+	node.prio_next = after ? after->sleep_node.prio_next : m_prio_head;
+	(node.prio_next ? node.prio_next->sleep_node.prio_prev : m_prio_tail) = cpu;
+	(after ? after->sleep_node.prio_next : m_prio_head) = cpu;
+}
+
+void lv2_sleep_queue::relink_priority() noexcept
+{
+	AUDIT(!m_mutex.is_free());
+
+	// Arrival order keeps the order among equal priorities
+	for (cpu_thread* cpu = m_head; cpu; cpu = cpu->sleep_node.next)
+	{
+		auto& node = cpu->sleep_node;
+
+		if (cpu->id_type() != 1)
+		{
+			continue;
+		}
+
+		const s32 prio = std::min<s32>(static_cast<ppu_thread*>(cpu)->prio, 3071);
+
+		if (node.prio != prio)
+		{
+			(node.prio_prev ? node.prio_prev->sleep_node.prio_next : m_prio_head) = node.prio_next;
+			(node.prio_next ? node.prio_next->sleep_node.prio_prev : m_prio_tail) = node.prio_prev;
+
+			node.prio = prio;
+			link_priority(cpu);
+		}
+	}
+}
+
+DECLARE(lv2_sleep_queue::g_prio_changes);
 DECLARE(lv2_obj::g_mutex);
 DECLARE(lv2_obj::g_ppu);
 DECLARE(lv2_obj::g_pending);
@@ -1176,6 +1242,7 @@ void lv2_obj::sleep_unlocked(cpu_thread& thread, u64 timeout)
 
 		ppu->raddr = 0; // Clear reservation
 		ppu->start_time = start_time;
+		ppu->sleep_count++;
 	}
 
 	if (timeout)
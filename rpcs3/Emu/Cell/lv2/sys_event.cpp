@@ -54,7 +54,7 @@ CellError lv2_event_queue::send(lv2_event event)
 
 	if (sq.empty())
 	{
-		if (events.size() < this->size + 0u)
+		if (!events.full())
 		{
 			// Save event
 			events.emplace_back(event);
@@ -76,10 +76,8 @@ CellError lv2_event_queue::send(lv2_event event)
 	else
 	{
 		// Store event in In_MBox
-		auto& spu = static_cast<spu_thread&>(*sq.front());
-
 		// TODO: use protocol?
-		sq.pop_front();
+		auto& spu = static_cast<spu_thread&>(*sq.pop(SYS_SYNC_FIFO));
 
 		const u32 data1 = static_cast<u32>(std::get<1>(event));
 		const u32 data2 = static_cast<u32>(std::get<2>(event));
@@ -199,20 +197,22 @@ error_code sys_event_queue_destroy(ppu_thread& ppu, u32 equeue_id, s32 mode)
 
 		if (queue->type == SYS_PPU_QUEUE)
 		{
-			for (auto cpu : queue->sq)
+			const bool had_waiters = !queue->sq.empty();
+
+			while (const auto cpu = queue->sq.pop(SYS_SYNC_FIFO))
 			{
 				static_cast<ppu_thread&>(*cpu).gpr[3] = CELL_ECANCELED;
 				queue->append(cpu);
 			}
 
-			if (!queue->sq.empty())
+			if (had_waiters)
 			{
 				lv2_obj::awake_all();
 			}
 		}
 		else
 		{
-			for (auto cpu : queue->sq)
+			while (const auto cpu = queue->sq.pop(SYS_SYNC_FIFO))
 			{
 				static_cast<spu_thread&>(*cpu).ch_in_mbox.set_values(1, CELL_ECANCELED);
 				cpu->state += cpu_flag::signal;
@@ -75,6 +75,63 @@ struct sys_event_t
 // Source, data1, data2, data3
 using lv2_event = std::tuple<u64, u64, u64, u64>;
 
+// Pending events of a queue, storage is allocated once for the queue depth
+class lv2_event_ring
+{
+	const std::unique_ptr<lv2_event[]> m_data;
+	const u32 m_capacity;
+	u32 m_head = 0;
+	u32 m_count = 0;
+
+public:
+	explicit lv2_event_ring(u32 capacity)
+		: m_data(std::make_unique<lv2_event[]>(capacity))
+		, m_capacity(capacity)
+	{
+	}
+
+	bool empty() const
+	{
+		return m_count == 0;
+	}
+
+	u32 size() const
+	{
+		return m_count;
+	}
+
+	bool full() const
+	{
+		return m_count == m_capacity;
+	}
+
+	const lv2_event& front() const
+	{
+		return m_data[m_head];
+	}
+
+	// Must not be full
+	void emplace_back(const lv2_event& event)
+	{
+		const u32 pos = m_head + m_count;
+		m_data[pos >= m_capacity ? pos - m_capacity : pos] = event;
+		m_count++;
+	}
+
+	// Must not be empty
+	void pop_front()
+	{
+		m_head = m_head + 1 == m_capacity ? 0 : m_head + 1;
+		m_count--;
+	}
+
+	void clear()
+	{
+		m_head = 0;
+		m_count = 0;
+	}
+};
+
 struct lv2_event_queue final : public lv2_obj
 {
 	static const u32 id_base = 0x8d000000;
@@ -87,8 +144,8 @@ struct lv2_event_queue final : public lv2_obj
 
 	atomic_t<u32> exists = 0; // Existence validation (workaround for shared-ptr ref-counting)
 	shared_mutex mutex;
-	std::deque<lv2_event> events;
-	std::deque<cpu_thread*> sq;
+	lv2_event_ring events;
+	lv2_sleep_queue sq{mutex};
 
 	lv2_event_queue(u32 protocol, s32 type, u64 name, u64 ipc_key, s32 size)
 		: protocol{protocol}
@@ -96,6 +153,7 @@ struct lv2_event_queue final : public lv2_obj
 		, name(name)
 		, key(ipc_key)
 		, size(size)
+		, events(size)
 	{
 	}
 
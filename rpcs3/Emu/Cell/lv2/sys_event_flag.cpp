@@ -272,14 +272,8 @@ error_code sys_event_flag_set(cpu_thread& cpu, u32 id, u64 bitptn)
 	{
 		std::lock_guard lock(flag->mutex);
 
-		// Sort sleep queue in required order
-		if (flag->protocol != SYS_SYNC_FIFO)
-		{
-			std::stable_sort(flag->sq.begin(), flag->sq.end(), [](cpu_thread* a, cpu_thread* b)
-			{
-				return static_cast<ppu_thread*>(a)->prio < static_cast<ppu_thread*>(b)->prio;
-			});
-		}
+		// Waiters are checked in priority order unless the protocol is FIFO
+		const bool fifo = flag->protocol == SYS_SYNC_FIFO;
 
 		// Process all waiters in single atomic op
 		const u32 count = flag->pattern.atomic_op([&](u64& value)
@@ -287,7 +281,7 @@ error_code sys_event_flag_set(cpu_thread& cpu, u32 id, u64 bitptn)
 			value |= bitptn;
 			u32 count = 0;
 
-			for (auto cpu : flag->sq)
+			auto check = [&](cpu_thread* cpu)
 			{
 				auto& ppu = static_cast<ppu_thread&>(*cpu);
 
@@ -303,6 +297,21 @@ error_code sys_event_flag_set(cpu_thread& cpu, u32 id, u64 bitptn)
 				{
 					ppu.gpr[3] = -1;
 				}
+			};
+
+			if (fifo)
+			{
+				for (auto cpu : flag->sq)
+				{
+					check(cpu);
+				}
+			}
+			else
+			{
+				for (auto cpu : flag->sq.by_priority())
+				{
+					check(cpu);
+				}
 			}
 
 			return count;
@@ -313,26 +322,23 @@ error_code sys_event_flag_set(cpu_thread& cpu, u32 id, u64 bitptn)
 			return CELL_OK;
 		}
 
-		// Remove waiters
-		const auto tail = std::remove_if(flag->sq.begin(), flag->sq.end(), [&](cpu_thread* cpu)
+		// Remove waiters (in the same order)
+		for (cpu_thread* cpu = fifo ? flag->sq.front() : flag->sq.by_priority().first; cpu;)
 		{
 			auto& ppu = static_cast<ppu_thread&>(*cpu);
+			const auto next = fifo ? cpu->sleep_node.next : cpu->sleep_node.prio_next;
 
 			if (ppu.gpr[3] == CELL_OK)
 			{
+				flag->sq.erase(cpu);
 				flag->waiters--;
 				flag->append(cpu);
-				return true;
 			}
 
-			return false;
-		});
-
-		if (tail != flag->sq.end())
-		{
-			flag->sq.erase(tail, flag->sq.end());
-			lv2_obj::awake_all();
+			cpu = next;
 		}
+
+		lv2_obj::awake_all();
 	}
 
 	return CELL_OK;
@@ -383,7 +389,7 @@ error_code sys_event_flag_cancel(ppu_thread& ppu, u32 id, vm::ptr<u32> num)
 		value = ::size32(flag->sq);
 
 		// Signal all threads to return CELL_ECANCELED (protocol does not matter)
-		for (auto thread : ::as_rvalue(std::move(flag->sq)))
+		while (const auto thread = flag->sq.pop(SYS_SYNC_FIFO))
 		{
 			auto& ppu = static_cast<ppu_thread&>(*thread);
 
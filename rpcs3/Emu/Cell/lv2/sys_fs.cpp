@@ -172,6 +172,8 @@ u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 		}
 	}
 
+	// File size and time changed
+	vfs::host::invalidate();
 	return result;
 }
 
@@ -285,7 +287,11 @@ lv2_file::open_raw_result_t lv2_file::open_raw(const std::string& local_path, s3
 {
 	// TODO: other checks for path
 
-	if (fs::is_dir(local_path))
+	fs::stat_t info{};
+	const bool exists = vfs::host::stat(local_path, info);
+	const bool missing = !exists && fs::g_tls_error == fs::error::noent;
+
+	if (exists && info.is_directory)
 	{
 		return {CELL_EISDIR};
 	}
@@ -363,7 +369,22 @@ lv2_file::open_raw_result_t lv2_file::open_raw(const std::string& local_path, s3
 
 	std::lock_guard lock(mp->mutex);
 
-	fs::file file(local_path, open_mode);
+	fs::file file;
+
+	if (missing && open_mode == fs::read)
+	{
+		// Known to not exist, skip the host call
+		fs::g_tls_error = fs::error::noent;
+	}
+	else
+	{
+		file.open(local_path, open_mode);
+
+		if (open_mode & (fs::write + fs::create + fs::trunc))
+		{
+			vfs::host::invalidate();
+		}
+	}
 
 	if (!file && open_mode == fs::read && fs::g_tls_error == fs::error::noent)
 	{
@@ -951,7 +972,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 
 	fs::stat_t info{};
 
-	if (!fs::stat(local_path, info))
+	if (!vfs::host::stat(local_path, info))
 	{
 		switch (auto error = fs::g_tls_error)
 		{
@@ -962,7 +983,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 
 			for (u32 i = 66601; i <= 66699; i++)
 			{
-				if (fs::stat(fmt::format("%s.%u", local_path, i), info) && !info.is_directory)
+				if (vfs::host::stat(fmt::format("%s.%u", local_path, i), info) && !info.is_directory)
 				{
 					total_size += info.size;
 				}
@@ -973,7 +994,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 			}
 
 			// Use attributes from the first fragment (consistently with sys_fs_open+fstat)
-			if (fs::stat(local_path + ".66600", info) && !info.is_directory)
+			if (vfs::host::stat(local_path + ".66600", info) && !info.is_directory)
 			{
 				// Success
 				info.size += total_size;
@@ -1108,6 +1129,7 @@ error_code sys_fs_mkdir(ppu_thread& ppu, vm::cptr<char> path, s32 mode)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate();
 	sys_fs.notice("sys_fs_mkdir(): directory %s created", path);
 	return CELL_OK;
 }
@@ -1214,6 +1236,7 @@ error_code sys_fs_rmdir(ppu_thread& ppu, vm::cptr<char> path)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate();
 	sys_fs.notice("sys_fs_rmdir(): directory %s removed", path);
 	return CELL_OK;
 }
@@ -1932,6 +1955,7 @@ error_code sys_fs_truncate(ppu_thread& ppu, vm::cptr<char> path, u64 size)
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate();
 	return CELL_OK;
 }
 
@@ -1982,6 +2006,7 @@ error_code sys_fs_ftruncate(ppu_thread& ppu, u32 fd, u64 size)
 		return CELL_EIO; // ???
 	}
 
+	vfs::host::invalidate();
 	return CELL_OK;
 }
 
@@ -2125,6 +2150,7 @@ error_code sys_fs_utime(ppu_thread& ppu, vm::cptr<char> path, vm::cptr<CellFsUti
 		return {CELL_EIO, path}; // ???
 	}
 
+	vfs::host::invalidate();
 	return CELL_OK;
 }
 
@@ -32,7 +32,7 @@ struct lv2_lwcond final : lv2_obj
 
 	shared_mutex mutex;
 	atomic_t<u32> waiters{0};
-	std::deque<cpu_thread*> sq;
+	lv2_sleep_queue sq{mutex};
 
 	lv2_lwcond(u64 name, u32 lwid, u32 protocol, vm::ptr<sys_lwcond_t> control)
 		: name(std::bit_cast<be_t<u64>>(name))
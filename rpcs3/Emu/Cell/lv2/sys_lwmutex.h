@@ -61,7 +61,7 @@ struct lv2_lwmutex final : lv2_obj
 
 	shared_mutex mutex;
 	atomic_t<s32> signaled{0};
-	std::deque<cpu_thread*> sq;
+	lv2_sleep_queue sq{mutex};
 	atomic_t<s32> lwcond_waiters{0};
 
 	lv2_lwmutex(u32 protocol, vm::ptr<sys_lwmutex_t> control, u64 name)
@@ -43,7 +43,7 @@ struct lv2_mutex final : lv2_obj
 	atomic_t<u32> owner{0};
 	atomic_t<u32> lock_count{0}; // Recursive Locks
 	atomic_t<count_info> obj_count{};
-	std::deque<cpu_thread*> sq;
+	lv2_sleep_queue sq{mutex};
 
 	lv2_mutex(u32 protocol, u32 recursive, u32 shared, u32 adaptive, u64 key, s32 flags, u64 name)
 		: protocol{protocol}
@@ -23,6 +23,11 @@
 #include <poll.h>
 #endif
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
 #include "Emu/NP/np_handler.h"
 
 #include <chrono>
@@ -273,6 +278,13 @@ static sys_net_error get_last_error(bool is_blocking, int native_error = 0)
 #undef ERROR_CASE
 }
 
+// Forget cached "not ready" states which are no longer watched by the network thread (network mutex must be locked)
+static void network_forget_unwatched(lv2_socket& sock)
+{
+	const auto known = sock.ready_known.load();
+	sock.ready_known -= known - sock.ready.load() - sock.events.load();
+}
+
 static void network_clear_queue(ppu_thread& ppu)
 {
 	idm::select<lv2_socket>([&](u32, lv2_socket& sock)
@@ -293,6 +305,7 @@ static void network_clear_queue(ppu_thread& ppu)
 		if (sock.queue.empty())
 		{
 			sock.events.store({});
+			network_forget_unwatched(sock);
 		}
 	});
 }
@@ -961,7 +974,7 @@ struct nt_p2p_port
 	}
 };
 
-struct network_thread
+struct network_thread : public need_wakeup
 {
 	std::vector<ppu_thread*> s_to_awake;
 	shared_mutex s_nw_mutex;
@@ -971,6 +984,30 @@ struct network_thread
 
 	static constexpr auto thread_name = "Network Thread";
 
+#ifdef __linux__
+	// Persistent epoll set (sockets are only re-registered when their interest changes)
+	int m_epoll_fd = -1;
+	int m_event_fd = -1;
+	atomic_t<bool> m_wake_pending = false;
+
+	// Sockets whose interest changed or which were closed since the last wakeup
+	shared_mutex m_epoll_updates_mutex;
+	std::vector<u32> m_epoll_updates;
+
+	struct epoll_entry
+	{
+		lv2_socket::socket_type fd;
+		u32 mask;
+	};
+
+	// Registered sockets (id -> native socket and mask) and P2P ports, only used by the network thread
+	std::unordered_map<u32, epoll_entry> m_epoll_sockets;
+	std::set<u16> m_epoll_p2p_ports;
+
+	static constexpr u64 c_epoll_wake_key = ~0ull;
+	static constexpr u64 c_epoll_p2p_flag = 1ull << 32;
+#endif
+
 	network_thread() noexcept
 	{
 #ifdef _WIN32
@@ -979,6 +1016,28 @@ struct network_thread
 #endif
 		if (g_cfg.net.psn_status == np_psn_status::rpcn)
 			list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(3658), std::forward_as_tuple(3658));
+
+#ifdef __linux__
+		m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+		m_event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		::epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.u64 = c_epoll_wake_key;
+
+		if (m_epoll_fd < 0 || m_event_fd < 0 || ::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &ev) != 0)
+		{
+			sys_net.error("Failed to set up epoll, falling back to poll (%d)", errno);
+
+			if (m_epoll_fd >= 0)
+				::close(m_epoll_fd);
+			if (m_event_fd >= 0)
+				::close(m_event_fd);
+
+			m_epoll_fd = -1;
+			m_event_fd = -1;
+		}
+#endif
 	}
 
 	~network_thread()
@@ -986,10 +1045,354 @@ struct network_thread
 #ifdef _WIN32
 		WSACleanup();
 #endif
+#ifdef __linux__
+		if (m_epoll_fd >= 0)
+			::close(m_epoll_fd);
+		if (m_event_fd >= 0)
+			::close(m_event_fd);
+#endif
+	}
+
+	// Whether the readiness of sockets is tracked (lv2_socket::ready), allowing poll/select without a host call
+	bool tracks_readiness() const
+	{
+#ifdef __linux__
+		return m_epoll_fd >= 0;
+#else
+		return false;
+#endif
+	}
+
+	// Make the thread pick up socket interest changes (new waiters, closed sockets, new P2P ports) immediately
+	// Only the socket with the given id is updated (0 only checks the P2P ports)
+	void wake_up(u32 id = 0)
+	{
+#ifdef __linux__
+		if (m_event_fd < 0)
+		{
+			return;
+		}
+
+		if (id)
+		{
+			std::lock_guard lock(m_epoll_updates_mutex);
+			m_epoll_updates.emplace_back(id);
+		}
+
+		if (!m_wake_pending.exchange(true))
+		{
+			const u64 value = 1;
+			[[maybe_unused]] const auto res = ::write(m_event_fd, &value, sizeof(value));
+		}
+#endif
+	}
+
+#ifdef __linux__
+	static u32 get_epoll_mask(bs_t<lv2_socket::poll> events)
+	{
+		return (events & lv2_socket::poll::read ? EPOLLIN : 0) | (events & lv2_socket::poll::write ? EPOLLOUT : 0);
+	}
+
+	void epoll_update(u32 id, lv2_socket::socket_type fd, bs_t<lv2_socket::poll> events)
+	{
+		const auto found = m_epoll_sockets.find(id);
+
+		if (!events)
+		{
+			// Not waited for: unregister, as hangup and errors would be reported regardless of the mask
+			if (found != m_epoll_sockets.end())
+			{
+				::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, found->second.fd, nullptr);
+				m_epoll_sockets.erase(found);
+			}
+
+			return;
+		}
+
+		const u32 mask = get_epoll_mask(events);
+
+		if (found != m_epoll_sockets.end() && found->second.mask == mask)
+		{
+			return;
+		}
+
+		::epoll_event ev{};
+		ev.events = mask;
+		ev.data.u64 = id;
+
+		if (::epoll_ctl(m_epoll_fd, found != m_epoll_sockets.end() ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev) != 0)
+		{
+			sys_net.error("epoll_ctl() failed for socket %d (%d)", id, errno);
+			return;
+		}
+
+		m_epoll_sockets[id] = {fd, mask};
+	}
+
+	void epoll_remove(u32 id)
+	{
+		if (const auto found = m_epoll_sockets.find(id); found != m_epoll_sockets.end())
+		{
+			::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, found->second.fd, nullptr);
+			m_epoll_sockets.erase(found);
+		}
+	}
+
+	// Apply the interest changes of the sockets passed to wake_up()
+	void epoll_sync_updates()
+	{
+		std::vector<u32> updates;
+		{
+			std::lock_guard lock(m_epoll_updates_mutex);
+			updates.swap(m_epoll_updates);
+		}
+
+		std::sort(updates.begin(), updates.end());
+		updates.erase(std::unique(updates.begin(), updates.end()), updates.end());
+
+		std::vector<std::shared_ptr<lv2_socket>> socks(updates.size());
+
+		// Drop closed sockets first, their descriptor may already be reused by a new one
+		for (usz i = 0; i < updates.size(); i++)
+		{
+			socks[i] = idm::get<lv2_socket>(updates[i]);
+
+			if (const auto found = m_epoll_sockets.find(updates[i]); found != m_epoll_sockets.end() && (!socks[i] || socks[i]->socket != found->second.fd))
+			{
+				epoll_remove(updates[i]);
+			}
+		}
+
+		for (usz i = 0; i < updates.size(); i++)
+		{
+			if (const auto& sock = socks[i]; sock && sock->type != SYS_NET_SOCK_DGRAM_P2P && sock->type != SYS_NET_SOCK_STREAM_P2P)
+			{
+				epoll_update(updates[i], sock->socket, sock->events.load());
+			}
+		}
+
+		epoll_sync_p2p();
+	}
+
+	// Bring the epoll set in line with the current sockets and P2P ports
+	void epoll_sync()
+	{
+		std::unordered_map<u32, std::pair<lv2_socket::socket_type, bs_t<lv2_socket::poll>>> sockets;
+
+		idm::select<lv2_socket>([&](u32 id, lv2_socket& s)
+		{
+			if (s.type != SYS_NET_SOCK_DGRAM_P2P && s.type != SYS_NET_SOCK_STREAM_P2P)
+				sockets.emplace(id, std::make_pair(s.socket, s.events.load()));
+		});
+
+		// Drop closed sockets first, their descriptor may already be reused by a new one
+		for (auto it = m_epoll_sockets.begin(); it != m_epoll_sockets.end();)
+		{
+			const auto found = sockets.find(it->first);
+
+			if (found == sockets.end() || found->second.first != it->second.fd)
+			{
+				::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+				it = m_epoll_sockets.erase(it);
+				continue;
+			}
+
+			it++;
+		}
+
+		for (const auto& [id, sock] : sockets)
+		{
+			epoll_update(id, sock.first, sock.second);
+		}
+
+		epoll_sync_p2p();
 	}
 
+	void epoll_sync_p2p()
+	{
+		std::lock_guard lock(list_p2p_ports_mutex);
+
+		for (const auto& [port, p2p_port] : list_p2p_ports)
+		{
+			if (m_epoll_p2p_ports.count(port))
+			{
+				continue;
+			}
+
+			::epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.u64 = c_epoll_p2p_flag | port;
+
+			if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, p2p_port.p2p_socket, &ev) != 0)
+			{
+				sys_net.error("[P2P] epoll_ctl() failed for port %d (%d)", port, errno);
+				continue;
+			}
+
+			m_epoll_p2p_ports.emplace(port);
+		}
+	}
+
+	void run_epoll()
+	{
+		std::array<::epoll_event, 64> evs;
+
+		epoll_sync();
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			// Interest changes wake the thread through the eventfd, a full resync is only done as a fallback when idle
+			const int count = ::epoll_wait(m_epoll_fd, evs.data(), ::size32(evs), 100);
+
+			if (count < 0)
+			{
+				if (errno != EINTR)
+				{
+					sys_net.error("epoll_wait() failed (%d)", errno);
+				}
+
+				continue;
+			}
+
+			const bool resync = count == 0;
+			bool updates = false;
+
+			// Receive P2P packets first
+			for (int i = 0; i < count; i++)
+			{
+				const u64 key = evs[i].data.u64;
+
+				if (key == c_epoll_wake_key)
+				{
+					u64 value;
+					[[maybe_unused]] const auto res = ::read(m_event_fd, &value, sizeof(value));
+					m_wake_pending.release(false);
+					updates = true;
+				}
+				else if (key & c_epoll_p2p_flag)
+				{
+					std::lock_guard lock(list_p2p_ports_mutex);
+
+					if (const auto found = list_p2p_ports.find(static_cast<u16>(key)); found != list_p2p_ports.end())
+					{
+						while (found->second.recv_data());
+					}
+				}
+			}
+
+			std::lock_guard lock(s_nw_mutex);
+
+			for (int i = 0; i < count; i++)
+			{
+				const u64 key = evs[i].data.u64;
+
+				if (key == c_epoll_wake_key || key & c_epoll_p2p_flag)
+				{
+					continue;
+				}
+
+				const u32 id = static_cast<u32>(key);
+				const auto entry = m_epoll_sockets.find(id);
+
+				if (entry == m_epoll_sockets.end())
+				{
+					continue;
+				}
+
+				const auto sock = idm::get<lv2_socket>(id);
+
+				if (!sock || sock->socket != entry->second.fd)
+				{
+					// Closed, removed by the update queued in sys_net_bnet_close
+					continue;
+				}
+
+				const u32 revents = evs[i].events;
+				bs_t<lv2_socket::poll> events{};
+
+				// Update the readiness cache, states reported by epoll are known to be ready
+				bs_t<lv2_socket::poll> fired{};
+
+				if (revents & (EPOLLIN | EPOLLHUP))
+					fired += lv2_socket::poll::read;
+				if (revents & EPOLLOUT)
+					fired += lv2_socket::poll::write;
+				if (revents & EPOLLERR)
+					fired += lv2_socket::poll::error;
+
+				sock->ready += fired;
+				sock->ready_known += fired;
+
+				if (revents & (EPOLLIN | EPOLLHUP) && sock->events.test_and_reset(lv2_socket::poll::read))
+					events += lv2_socket::poll::read;
+				if (revents & EPOLLOUT && sock->events.test_and_reset(lv2_socket::poll::write))
+					events += lv2_socket::poll::write;
+				if (revents & EPOLLERR && sock->events.test_and_reset(lv2_socket::poll::error))
+					events += lv2_socket::poll::error;
+
+				if (events)
+				{
+					std::lock_guard lock(sock->mutex);
+
+					for (auto it = sock->queue.begin(); events && it != sock->queue.end();)
+					{
+						if (it->second(events))
+						{
+							it = sock->queue.erase(it);
+							continue;
+						}
+
+						it++;
+					}
+
+					if (sock->queue.empty())
+					{
+						sock->events.store({});
+					}
+				}
+
+				// Callbacks may have re-armed or dropped their interest (including the interest armed by poll/select)
+				network_forget_unwatched(*sock);
+				epoll_update(id, sock->socket, sock->events.load());
+			}
+
+			s_to_awake.erase(std::unique(s_to_awake.begin(), s_to_awake.end()), s_to_awake.end());
+
+			for (ppu_thread* ppu : s_to_awake)
+			{
+				network_clear_queue(*ppu);
+				lv2_obj::append(ppu);
+			}
+
+			if (!s_to_awake.empty())
+			{
+				lv2_obj::awake_all();
+			}
+
+			s_to_awake.clear();
+
+			if (resync)
+			{
+				epoll_sync();
+			}
+			else if (updates)
+			{
+				epoll_sync_updates();
+			}
+		}
+	}
+#endif
+
 	void operator()()
 	{
+#ifdef __linux__
+		if (m_epoll_fd >= 0)
+		{
+			run_epoll();
+			return;
+		}
+#endif
+
 		std::vector<std::shared_ptr<lv2_socket>> socklist;
 		socklist.reserve(lv2_socket::id_count);
 
@@ -1141,6 +1544,63 @@ struct network_thread
 
 using network_context = named_thread<network_thread>;
 
+// Notify the network thread that a socket is now waited on or was closed
+static void network_wake_up(u32 id)
+{
+	g_fxo->get<network_context>().wake_up(id);
+}
+
+// Try to answer poll/select from cached readiness (network mutex must be locked)
+static bool network_poll_cached(lv2_socket& sock, bs_t<lv2_socket::poll> selected, bs_t<lv2_socket::poll>& ready)
+{
+	// Errors are only known when reported
+	const auto required = selected - lv2_socket::poll::error;
+	const auto known = sock.ready_known.load();
+
+	if (sock.type == SYS_NET_SOCK_DGRAM_P2P || sock.type == SYS_NET_SOCK_STREAM_P2P || !g_fxo->get<network_context>().tracks_readiness() || (known & required) != required)
+	{
+		return false;
+	}
+
+	ready = sock.ready & known & selected;
+	return true;
+}
+
+// Store host poll result (network mutex must be locked), makes the network thread watch the socket if not ready
+static void network_poll_store(u32 id, lv2_socket& sock, const ::pollfd& pfd)
+{
+	if (sock.type == SYS_NET_SOCK_DGRAM_P2P || sock.type == SYS_NET_SOCK_STREAM_P2P || !g_fxo->get<network_context>().tracks_readiness())
+	{
+		return;
+	}
+
+	bs_t<lv2_socket::poll> selected = +lv2_socket::poll::error, ready{};
+
+	if (pfd.events & POLLIN)
+		selected += lv2_socket::poll::read;
+	if (pfd.events & POLLOUT)
+		selected += lv2_socket::poll::write;
+	if (pfd.revents & (POLLIN | POLLHUP))
+		ready += lv2_socket::poll::read;
+	if (pfd.revents & POLLOUT)
+		ready += lv2_socket::poll::write;
+	if (pfd.revents & POLLERR)
+		ready += lv2_socket::poll::error;
+
+	ready = ready & selected;
+
+	sock.ready -= selected;
+	sock.ready += ready;
+	sock.ready_known += (selected - lv2_socket::poll::error) + ready;
+
+	if (const auto pending = selected - ready - lv2_socket::poll::error)
+	{
+		// States which are not ready stay valid only while epoll watches them
+		sock.events += pending;
+		network_wake_up(id);
+	}
+}
+
 // Used by RPCN to send signaling packets to RPCN server(for UDP hole punching)
 s32 send_packet_from_p2p_port(const std::vector<u8>& data, const sockaddr_in& addr)
 {
@@ -1284,6 +1744,8 @@ error_code sys_net_bnet_accept(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr>
 					return false;
 				});
 
+				network_wake_up(s);
+
 				lv2_obj::sleep(ppu);
 				return false;
 			}
@@ -1297,6 +1759,7 @@ error_code sys_net_bnet_accept(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr>
 		//if (!(sock.events & lv2_socket::poll::read))
 		{
 			native_socket = ::accept(sock.socket, reinterpret_cast<struct sockaddr*>(&native_addr), &native_addrlen);
+			sock.ready_known -= lv2_socket::poll::read;
 
 			if (native_socket != -1)
 			{
@@ -1318,6 +1781,7 @@ error_code sys_net_bnet_accept(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr>
 			if (events & lv2_socket::poll::read)
 			{
 				native_socket = ::accept(sock.socket, reinterpret_cast<struct sockaddr*>(&native_addr), &native_addrlen);
+				sock.ready_known -= lv2_socket::poll::read;
 
 				if (native_socket != -1 || (result = get_last_error(!sock.so_nbio)))
 				{
@@ -1330,6 +1794,8 @@ error_code sys_net_bnet_accept(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr>
 			return false;
 		});
 
+		network_wake_up(s);
+
 		lv2_obj::sleep(ppu);
 		return false;
 	});
@@ -1487,6 +1953,7 @@ error_code sys_net_bnet_bind(ppu_thread& ppu, s32 s, vm::cptr<sys_net_sockaddr>
 				if (nc.list_p2p_ports.count(p2p_port) == 0)
 				{
 					nc.list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(p2p_port), std::forward_as_tuple(p2p_port));
+					nc.wake_up();
 				}
 
 				auto& pport = nc.list_p2p_ports.at(p2p_port);
@@ -1602,7 +2069,10 @@ error_code sys_net_bnet_connect(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr
 				{
 					std::lock_guard list_lock(nc.list_p2p_ports_mutex);
 					if (!nc.list_p2p_ports.count(sock.p2p.port))
+					{
 						nc.list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(sock.p2p.port), std::forward_as_tuple(sock.p2p.port));
+						nc.wake_up();
+					}
 
 					auto& pport = nc.list_p2p_ports.at(sock.p2p.port);
 					real_socket = pport.p2p_socket;
@@ -1674,6 +2144,8 @@ error_code sys_net_bnet_connect(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr
 			sys_net.error("sys_net_bnet_connect(s=%d): unsupported sa_family (%d)", s, _addr->sa_family);
 		}
 
+		sock.ready_known.release({});
+
 		if (::connect(sock.socket, reinterpret_cast<struct sockaddr*>(&name), namelen) == 0)
 		{
 			return true;
@@ -1718,6 +2190,8 @@ error_code sys_net_bnet_connect(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr
 					sock.events += lv2_socket::poll::write;
 					return false;
 				});
+
+				network_wake_up(s);
 			}
 
 			return false;
@@ -1751,6 +2225,8 @@ error_code sys_net_bnet_connect(ppu_thread& ppu, s32 s, vm::ptr<sys_net_sockaddr
 			return false;
 		});
 
+		network_wake_up(s);
+
 		lv2_obj::sleep(ppu);
 		return false;
 	});
@@ -2176,6 +2652,8 @@ error_code sys_net_bnet_listen(ppu_thread& ppu, s32 s, s32 backlog)
 
 		ensure(sock.type == SYS_NET_SOCK_STREAM_P2P || sock.type == SYS_NET_SOCK_STREAM);
 
+		sock.ready_known.release({});
+
 		if (sock.type == SYS_NET_SOCK_STREAM_P2P)
 		{
 			sock.p2ps.status = lv2_socket::p2ps_i::stream_status::stream_listening;
@@ -2354,6 +2832,8 @@ error_code sys_net_bnet_recvfrom(ppu_thread& ppu, s32 s, vm::ptr<void> buf, u32
 						return false;
 					});
 
+					network_wake_up(s);
+
 					lv2_obj::sleep(ppu);
 					return false;
 				}
@@ -2363,6 +2843,7 @@ error_code sys_net_bnet_recvfrom(ppu_thread& ppu, s32 s, vm::ptr<void> buf, u32
 			}
 
 			native_result = ::recvfrom(sock.socket, static_cast<char*>(buf.get_ptr()), len, native_flags, reinterpret_cast<struct sockaddr*>(&native_addr), &native_addrlen);
+			sock.ready_known -= lv2_socket::poll::read;
 
 			if (native_result >= 0)
 			{
@@ -2420,6 +2901,7 @@ error_code sys_net_bnet_recvfrom(ppu_thread& ppu, s32 s, vm::ptr<void> buf, u32
 			if (events & lv2_socket::poll::read)
 			{
 				native_result = ::recvfrom(sock.socket, reinterpret_cast<char *>(_buf.data()), len, native_flags, reinterpret_cast<struct sockaddr*>(&native_addr), &native_addrlen);
+				sock.ready_known -= lv2_socket::poll::read;
 
 				if (native_result >= 0 || (result = get_last_error(!sock.so_nbio && (flags & SYS_NET_MSG_DONTWAIT) == 0)))
 				{
@@ -2432,6 +2914,8 @@ error_code sys_net_bnet_recvfrom(ppu_thread& ppu, s32 s, vm::ptr<void> buf, u32
 			return false;
 		});
 
+		network_wake_up(s);
+
 		lv2_obj::sleep(ppu);
 		return false;
 	});
@@ -2682,6 +3166,7 @@ error_code sys_net_bnet_sendto(ppu_thread& ppu, s32 s, vm::cptr<void> buf, u32 l
 			}
 
 			native_result = ::sendto(sock.socket, data, data_len, native_flags, addr ? reinterpret_cast<struct sockaddr*>(&name) : nullptr, addr ? namelen : 0);
+			sock.ready_known -= lv2_socket::poll::write;
 
 			if (native_result >= 0)
 			{
@@ -2707,6 +3192,7 @@ error_code sys_net_bnet_sendto(ppu_thread& ppu, s32 s, vm::cptr<void> buf, u32 l
 			if (events & lv2_socket::poll::write)
 			{
 				native_result = ::sendto(sock.socket, data, data_len, native_flags, addr ? reinterpret_cast<struct sockaddr*>(&name) : nullptr, addr ? namelen : 0);
+				sock.ready_known -= lv2_socket::poll::write;
 
 				if (native_result >= 0 || (result = get_last_error(!sock.so_nbio && (flags & SYS_NET_MSG_DONTWAIT) == 0)))
 				{
@@ -2719,6 +3205,8 @@ error_code sys_net_bnet_sendto(ppu_thread& ppu, s32 s, vm::cptr<void> buf, u32 l
 			return false;
 		});
 
+		network_wake_up(s);
+
 		lv2_obj::sleep(ppu);
 		return false;
 	});
@@ -3025,6 +3513,8 @@ error_code sys_net_bnet_shutdown(ppu_thread& ppu, s32 s, s32 how)
 			how == SYS_NET_SHUT_WR ? SHUT_WR : SHUT_RDWR;
 #endif
 
+		sock.ready_known.release({});
+
 		if (::shutdown(sock.socket, native_how) == 0)
 		{
 			return {};
@@ -3131,6 +3621,8 @@ error_code sys_net_bnet_close(ppu_thread& ppu, s32 s)
 		return -SYS_NET_EBADF;
 	}
 
+	network_wake_up(s);
+
 	if (!sock->queue.empty())
 		sys_net.error("CLOSE");
 
@@ -3200,6 +3692,9 @@ error_code sys_net_bnet_poll(ppu_thread& ppu, vm::ptr<sys_net_pollfd> fds, s32 n
 		bool connecting[1024]{};
 #endif
 
+		// Sockets checked on the host, to update their cached readiness
+		lv2_socket* polled[1024]{};
+
 		for (s32 i = 0; i < nfds; i++)
 		{
 			_fds[i].fd = -1;
@@ -3262,11 +3757,33 @@ error_code sys_net_bnet_poll(ppu_thread& ppu, vm::ptr<sys_net_pollfd> fds, s32 n
 
 					if (fds_buf[i].events & ~(SYS_NET_POLLIN | SYS_NET_POLLOUT | SYS_NET_POLLERR))
 						sys_net.warning("sys_net_bnet_poll(fd=%d): events=0x%x", fds[i].fd, fds[i].events);
-					_fds[i].fd = sock->socket;
+
+					bs_t<lv2_socket::poll> selected = +lv2_socket::poll::error;
+
 					if (fds_buf[i].events & SYS_NET_POLLIN)
-						_fds[i].events |= POLLIN;
+						selected += lv2_socket::poll::read;
 					if (fds_buf[i].events & SYS_NET_POLLOUT)
-						_fds[i].events |= POLLOUT;
+						selected += lv2_socket::poll::write;
+
+					if (bs_t<lv2_socket::poll> ready; network_poll_cached(*sock, selected, ready))
+					{
+						if (ready & lv2_socket::poll::read)
+							fds_buf[i].revents |= SYS_NET_POLLIN;
+						if (ready & lv2_socket::poll::write)
+							fds_buf[i].revents |= SYS_NET_POLLOUT;
+						if (ready & lv2_socket::poll::error)
+							fds_buf[i].revents |= SYS_NET_POLLERR;
+					}
+					else
+					{
+						_fds[i].fd = sock->socket;
+						if (fds_buf[i].events & SYS_NET_POLLIN)
+							_fds[i].events |= POLLIN;
+						if (fds_buf[i].events & SYS_NET_POLLOUT)
+							_fds[i].events |= POLLOUT;
+
+						polled[i] = sock;
+					}
 				}
 #ifdef _WIN32
 				connecting[i] = sock->is_connecting;
@@ -3279,11 +3796,15 @@ error_code sys_net_bnet_poll(ppu_thread& ppu, vm::ptr<sys_net_pollfd> fds, s32 n
 			}
 		}
 
+		if (std::any_of(_fds, _fds + nfds, [](const ::pollfd& pfd) { return pfd.fd != -1; }))
+		{
 #ifdef _WIN32
-		windows_poll(_fds, nfds, 0, connecting);
+			windows_poll(_fds, nfds, 0, connecting);
 #else
-		::poll(_fds, nfds, 0);
+			::poll(_fds, nfds, 0);
 #endif
+		}
+
 		for (s32 i = 0; i < nfds; i++)
 		{
 			if (_fds[i].revents & (POLLIN | POLLHUP))
@@ -3293,6 +3814,11 @@ error_code sys_net_bnet_poll(ppu_thread& ppu, vm::ptr<sys_net_pollfd> fds, s32 n
 			if (_fds[i].revents & POLLERR)
 				fds_buf[i].revents |= SYS_NET_POLLERR;
 
+			if (polled[i])
+			{
+				network_poll_store(fds_buf[i].fd, *polled[i], _fds[i]);
+			}
+
 			if (fds_buf[i].revents)
 			{
 				signaled++;
@@ -3351,6 +3877,8 @@ error_code sys_net_bnet_poll(ppu_thread& ppu, vm::ptr<sys_net_pollfd> fds, s32 n
 					sock->events += selected;
 					return false;
 				});
+
+				network_wake_up(fds_buf[i].fd);
 			}
 		}
 
@@ -3436,6 +3964,9 @@ error_code sys_net_bnet_select(ppu_thread& ppu, s32 nfds, vm::ptr<sys_net_fd_set
 		bool connecting[1024]{};
 #endif
 
+		// Sockets checked on the host, to update their cached readiness
+		lv2_socket* polled[1024]{};
+
 		for (s32 i = 0; i < nfds; i++)
 		{
 			_fds[i].fd = -1;
@@ -3460,13 +3991,27 @@ error_code sys_net_bnet_select(ppu_thread& ppu, s32 nfds, vm::ptr<sys_net_fd_set
 			if (auto sock = idm::check_unlocked<lv2_socket>((lv2_socket::id_base & -1024) + i))
 			{
 
-				if (sock->type != SYS_NET_SOCK_DGRAM_P2P)
+				if (bs_t<lv2_socket::poll> ready; network_poll_cached(*sock, selected, ready))
+				{
+					if (ready)
+					{
+						if (ready & (lv2_socket::poll::read + lv2_socket::poll::error))
+							rread.set(i);
+						if (ready & (lv2_socket::poll::write + lv2_socket::poll::error))
+							rwrite.set(i);
+
+						signaled++;
+					}
+				}
+				else if (sock->type != SYS_NET_SOCK_DGRAM_P2P)
 				{
 					_fds[i].fd = sock->socket;
 					if (selected & lv2_socket::poll::read)
 						_fds[i].events |= POLLIN;
 					if (selected & lv2_socket::poll::write)
 						_fds[i].events |= POLLOUT;
+
+					polled[i] = sock;
 				}
 				else
 				{
@@ -3489,11 +4034,15 @@ error_code sys_net_bnet_select(ppu_thread& ppu, s32 nfds, vm::ptr<sys_net_fd_set
 			}
 		}
 
+		if (std::any_of(_fds, _fds + nfds, [](const ::pollfd& pfd) { return pfd.fd != -1; }))
+		{
 #ifdef _WIN32
-		windows_poll(_fds, nfds, 0, connecting);
+			windows_poll(_fds, nfds, 0, connecting);
 #else
-		::poll(_fds, nfds, 0);
+			::poll(_fds, nfds, 0);
 #endif
+		}
+
 		for (s32 i = 0; i < nfds; i++)
 		{
 			bool sig = false;
@@ -3502,6 +4051,11 @@ error_code sys_net_bnet_select(ppu_thread& ppu, s32 nfds, vm::ptr<sys_net_fd_set
 			if (_fds[i].revents & (POLLOUT | POLLERR))
 				sig = true, rwrite.set(i);
 
+			if (polled[i])
+			{
+				network_poll_store((lv2_socket::id_base & -1024) + i, *polled[i], _fds[i]);
+			}
+
 			if (sig)
 			{
 				signaled++;
@@ -3567,6 +4121,8 @@ error_code sys_net_bnet_select(ppu_thread& ppu, s32 nfds, vm::ptr<sys_net_fd_set
 					sock->events += selected;
 					return false;
 				});
+
+				network_wake_up((lv2_socket::id_base & -1024) + i);
 			}
 			else
 			{
@@ -346,6 +346,12 @@ struct lv2_socket final
 	// Events selected for polling
 	atomic_bs_t<poll> events{};
 
+	// Cached host readiness for poll/select (epoll network thread only): states in ready_known are valid in ready.
+	// States only become known under the network mutex, a known "not ready" state stays valid only while it is in events.
+	// Operations which may change a state forget it under the socket mutex alone: it only forces the next poll to ask the host.
+	atomic_bs_t<poll> ready_known{};
+	atomic_bs_t<poll> ready{};
+
 	// Non-blocking IO option
 	s32 so_nbio = 0;
 
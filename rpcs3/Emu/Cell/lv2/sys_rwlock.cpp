@@ -373,7 +373,7 @@ error_code sys_rwlock_wlock(ppu_thread& ppu, u32 rw_lock_id, u64 timeout)
 					});
 
 					// Protocol doesn't matter here since they are all enqueued anyways
-					for (auto cpu : ::as_rvalue(std::move(rwlock->rq)))
+					while (const auto cpu = rwlock->rq.pop(SYS_SYNC_FIFO))
 					{
 						rwlock->append(cpu);
 					}
@@ -466,7 +466,7 @@ error_code sys_rwlock_wunlock(ppu_thread& ppu, u32 rw_lock_id)
 		}
 		else if (auto readers = rwlock->rq.size())
 		{
-			for (auto cpu : ::as_rvalue(std::move(rwlock->rq)))
+			while (const auto cpu = rwlock->rq.pop(SYS_SYNC_FIFO))
 			{
 				rwlock->append(cpu);
 			}
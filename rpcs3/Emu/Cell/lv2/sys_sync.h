@@ -60,6 +60,177 @@ enum
 	SYS_SYNC_ATTR_ADAPTIVE_MASK  = 0xf000,
 };
 
+// Intrusive queue of threads sleeping on an lv2 object, the links are stored in cpu_thread::sleep_node (no allocations).
+// Threads are linked both in arrival order and in priority order, so FIFO and priority wakeups as well as removal are O(1).
+// The priority is sampled when the thread is queued, priority changes are applied by the next priority wakeup. Must be protected by the object mutex.
+class lv2_sleep_queue
+{
+	// Object mutex protecting the queue
+	shared_mutex& m_mutex;
+
+	cpu_thread* m_head = nullptr;
+	cpu_thread* m_tail = nullptr;
+	cpu_thread* m_prio_head = nullptr;
+	cpu_thread* m_prio_tail = nullptr;
+	u32 m_size = 0;
+
+	// Value of g_prio_changes when the priority order was last checked
+	u64 m_prio_changes = 0;
+
+public:
+	// Iterates in arrival order or in priority order, erasing the current thread invalidates the iterator
+	template <bool Priority>
+	class iterator
+	{
+		cpu_thread* m_ptr;
+
+	public:
+		explicit iterator(cpu_thread* ptr) noexcept
+			: m_ptr(ptr)
+		{
+		}
+
+		cpu_thread* operator*() const noexcept
+		{
+			return m_ptr;
+		}
+
+		iterator& operator++() noexcept
+		{
+			m_ptr = Priority ? m_ptr->sleep_node.prio_next : m_ptr->sleep_node.next;
+			return *this;
+		}
+
+		bool operator==(const iterator&) const noexcept = default;
+	};
+
+	template <bool Priority>
+	struct range
+	{
+		cpu_thread* first;
+
+		iterator<Priority> begin() const noexcept
+		{
+			return iterator<Priority>{first};
+		}
+
+		iterator<Priority> end() const noexcept
+		{
+			return iterator<Priority>{nullptr};
+		}
+	};
+
+	// Incremented after every PPU priority change (the priority order of each queue is checked lazily)
+	static atomic_t<u64> g_prio_changes;
+
+	explicit lv2_sleep_queue(shared_mutex& mutex) noexcept
+		: m_mutex(mutex)
+	{
+	}
+
+	lv2_sleep_queue(const lv2_sleep_queue&) = delete;
+
+	lv2_sleep_queue& operator=(const lv2_sleep_queue&) = delete;
+
+	bool empty() const noexcept
+	{
+		return !m_head;
+	}
+
+	u32 size() const noexcept
+	{
+		return m_size;
+	}
+
+	// Oldest sleeping thread
+	cpu_thread* front() const noexcept
+	{
+		return m_head;
+	}
+
+	bool contains(const cpu_thread* cpu) const noexcept
+	{
+		return cpu->sleep_node.owner == this;
+	}
+
+	iterator<false> begin() const noexcept
+	{
+		return iterator<false>{m_head};
+	}
+
+	iterator<false> end() const noexcept
+	{
+		return iterator<false>{nullptr};
+	}
+
+	range<true> by_priority() noexcept
+	{
+		sync_priority();
+		return {m_prio_head};
+	}
+
+	// Queue the thread (PPU priority is taken from ppu_thread::prio)
+	void emplace_back(cpu_thread* cpu);
+
+	// Remove the thread, returns false if it isn't in this queue
+	bool erase(cpu_thread* cpu) noexcept
+	{
+		auto& node = cpu->sleep_node;
+
+		if (node.owner != this)
+		{
+			return false;
+		}
+
+		(node.prev ? node.prev->sleep_node.next : m_head) = node.next;
+		(node.next ? node.next->sleep_node.prev : m_tail) = node.prev;
+		(node.prio_prev ? node.prio_prev->sleep_node.prio_next : m_prio_head) = node.prio_next;
+		(node.prio_next ? node.prio_next->sleep_node.prio_prev : m_prio_tail) = node.prio_prev;
+
+		node.owner = nullptr;
+		node.next = nullptr;
+		node.prev = nullptr;
+		node.prio_next = nullptr;
+		node.prio_prev = nullptr;
+		m_size--;
+		return true;
+	}
+
+	// Dequeue the oldest thread for SYS_SYNC_FIFO, the highest priority one otherwise (arrival order among equals)
+	cpu_thread* pop(u32 protocol) noexcept
+	{
+		if (protocol != SYS_SYNC_FIFO)
+		{
+			sync_priority();
+		}
+
+		const auto cpu = protocol == SYS_SYNC_FIFO ? m_head : m_prio_head;
+
+		if (cpu)
+		{
+			erase(cpu);
+		}
+
+		return cpu;
+	}
+
+private:
+	// Insert the thread in priority order, after every thread with the same or better priority (usually the tail)
+	void link_priority(cpu_thread* cpu) noexcept;
+
+	// Move the threads whose priority changed since they were queued
+	void sync_priority() noexcept
+	{
+		if (const u64 changes = g_prio_changes; changes != m_prio_changes) [[unlikely]]
+		{
+			m_prio_changes = changes;
+			relink_priority();
+		}
+	}
+
+	void relink_priority() noexcept;
+};
+
 // Base class for some kernel objects (shared set of 8192 objects).
 struct lv2_obj
 {
@@ -112,38 +283,16 @@ public:
 		return nullptr;
 	}
 
-	template <typename E, typename T>
-	static T* schedule(std::deque<T*>& queue, u32 protocol)
+	template <typename E>
+	static cpu_thread* unqueue(lv2_sleep_queue& queue, E* object)
 	{
-		if (queue.empty())
-		{
-			return nullptr;
-		}
-
-		if (protocol == SYS_SYNC_FIFO)
-		{
-			const auto res = queue.front();
-			queue.pop_front();
-			return res;
-		}
-
-		s32 prio = 3071;
-		auto it = queue.cbegin();
-
-		for (auto found = it, end = queue.cend(); found != end; found++)
-		{
-			const s32 _prio = static_cast<E*>(*found)->prio;
-
-			if (_prio < prio)
-			{
-				it = found;
-				prio = _prio;
-			}
-		}
+		return queue.erase(object) ? object : nullptr;
+	}
 
-		const auto res = *it;
-		queue.erase(it);
-		return res;
+	template <typename E>
+	static E* schedule(lv2_sleep_queue& queue, u32 protocol)
+	{
+		return static_cast<E*>(queue.pop(protocol));
 	}
 
 private:
@@ -163,10 +312,55 @@ public:
 	// Returns true on successful context switch, false otherwise
 	static bool yield(cpu_thread& thread);
 
+	// Run a host task on a separate thread while the thread sleeps, letting other threads be scheduled meanwhile
+	template <typename F>
+	static void sleep_for_task(cpu_thread& cpu, std::string_view name, F&& func)
+	{
+		std::exception_ptr error;
+
+		sleep(cpu);
+
+		{
+			named_thread worker(name, [&]()
+			{
+				try
+				{
+					func();
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+
+				awake(&cpu);
+			});
+
+			while (auto state = cpu.state.fetch_sub(cpu_flag::signal))
+			{
+				if (is_stopped(state) || state & cpu_flag::signal)
+				{
+					break;
+				}
+
+				thread_ctrl::wait_on(cpu.state, state);
+			}
+
+			// The task must finish before returning, even if the thread is stopped
+		}
+
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+
 	static void set_priority(cpu_thread& thread, s32 prio)
 	{
 		ensure(prio + 512u < 3712);
 		awake(&thread, prio);
+
+		// Sleep queues pick up the new priority on their next priority wakeup
+		lv2_sleep_queue::g_prio_changes++;
 	}
 
 	static inline void awake_all()
@@ -93,7 +93,7 @@ public:
 	atomic_t<bool> is_init = false;
 
 	// sys_usbd_receive_event PPU Threads
-	std::deque<ppu_thread*> sq;
+	lv2_sleep_queue sq{mutex};
 
 	static constexpr auto thread_name = "Usb Manager Thread"sv;
 
@@ -520,7 +520,7 @@ error_code sys_usbd_finalize(ppu_thread& ppu, u32 handle)
 	usbh.is_init = false;
 
 	// Forcefully awake all waiters
-	for (auto& cpu : ::as_rvalue(std::move(usbh.sq)))
+	while (const auto cpu = lv2_obj::schedule<ppu_thread>(usbh.sq, SYS_SYNC_FIFO))
 	{
 		// Special ternimation signal value
 		cpu->gpr[4] = 4;
@@ -1,26 +1,40 @@
 #include "stdafx.h"
 #include "IdManager.h"
 #include "Utilities/Thread.h"
+#include "util/asm.hpp"
 
 shared_mutex id_manager::g_mutex;
 
 thread_local DECLARE(idm::g_id);
 
-idm::map_data* idm::allocate_id(std::vector<map_data>& vec, u32 type_id,  u32 base, u32 step, u32 count, std::pair<u32, u32> invl_range)
+void id_manager::id_slot::unpublish() noexcept
 {
-	if (vec.size() < count)
+	// Full barrier: the tag store must be visible before readers are checked (pairs with readers++ in read_id)
+	tag.exchange(0);
+
+	// Readers only copy the pointer, don't sleep
+	while (readers)
+	{
+		busy_wait(300);
+	}
+}
+
+id_manager::id_slot* idm::allocate_id(id_manager::id_storage& map, u32 type_id, u32 base, u32 step, u32 count, std::pair<u32, u32> invl_range)
+{
+	if (const u32 size = map.size; size < count)
 	{
-		// Try to emplace back
-		const u32 _next = base + step * ::size32(vec);
+		// Try to use the next unused slot
+		const u32 _next = base + step * size;
 		g_id = _next;
-		vec.emplace_back(id_manager::id_key(_next, type_id), nullptr);
-		return &vec.back();
+		map.slots[size].first = id_manager::id_key(_next, type_id);
+		map.size = size + 1;
+		return &map.slots[size];
 	}
 
 	// Check all IDs starting from "next id" (TODO)
 	for (u32 i = 0, next = base; i < count; i++, next += step)
 	{
-		const auto ptr = &vec[i];
+		const auto ptr = &map.slots[i];
 
 		// Look for free ID
 		if (!ptr->second)
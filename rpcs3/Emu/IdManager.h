@@ -138,16 +138,47 @@ namespace id_manager
 		}
 	};
 
-	template <typename T>
-	struct id_map
+	using map_data = std::pair<id_key, std::shared_ptr<void>>;
+
+	// ID record, the object is modified under the global mutex and published for lock-free readers
+	struct id_slot : map_data
+	{
+		// (type + 1) << 32 | id of the published object, 0 if the slot is empty
+		atomic_t<u64> tag{0};
+
+		// Number of lock-free readers currently accessing the object
+		atomic_t<u32> readers{0};
+
+		// Make the object visible to lock-free readers (call after setting it)
+		void publish() noexcept
+		{
+			tag.release((u64{first.type()} + 1) << 32 | first.value());
+		}
+
+		// Hide the object from lock-free readers and wait until they finish (call before resetting it)
+		void unpublish() noexcept;
+	};
+
+	// Fixed-size slot array, slots are never reallocated
+	struct id_storage
 	{
-		std::vector<std::pair<id_key, std::shared_ptr<void>>> vec;
-		shared_mutex mutex; // TODO: Use this instead of global mutex
+		const std::unique_ptr<id_slot[]> slots;
 
+		// Number of slots ever used (since the last clear)
+		atomic_t<u32> size{0};
+
+		explicit id_storage(u32 count)
+			: slots(new id_slot[count])
+		{
+		}
+	};
+
+	template <typename T>
+	struct id_map : id_storage
+	{
 		id_map()
+			: id_storage(T::id_count)
 		{
-			// Preallocate memory
-			vec.reserve(T::id_count);
 		}
 	};
 }
@@ -262,14 +293,14 @@ class idm
 		}
 	};
 
-	using map_data = std::pair<id_manager::id_key, std::shared_ptr<void>>;
+	using map_data = id_manager::map_data;
 
 	// Prepare new ID (returns nullptr if out of resources)
-	static map_data* allocate_id(std::vector<map_data>& vec, u32 type_id, u32 base, u32 step, u32 count, std::pair<u32, u32> invl_range);
+	static id_manager::id_slot* allocate_id(id_manager::id_storage& map, u32 type_id, u32 base, u32 step, u32 count, std::pair<u32, u32> invl_range);
 
-	// Find ID (additionally check type if types are not equal)
+	// Get ID record by index (nullptr if out of range)
 	template <typename T, typename Type>
-	static map_data* find_id(u32 id)
+	static id_manager::id_slot* find_slot(u32 id)
 	{
 		static_assert(id_manager::id_verify<T, Type>::value, "Invalid ID type combination");
 
@@ -280,14 +311,28 @@ class idm
 			return nullptr;
 		}
 
-		auto& vec = g_fxo->get<id_manager::id_map<T>>().vec;
+		auto& map = g_fxo->get<id_manager::id_map<T>>();
+
+		if (index >= map.size)
+		{
+			return nullptr;
+		}
+
+		return &map.slots[index];
+	}
+
+	// Find ID (additionally check type if types are not equal), requires the global mutex
+	template <typename T, typename Type>
+	static id_manager::id_slot* find_id(u32 id)
+	{
+		const auto slot = find_slot<T, Type>(id);
 
-		if (index >= vec.size())
+		if (!slot)
 		{
 			return nullptr;
 		}
 
-		auto& data = vec[index];
+		auto& data = *slot;
 
 		if (data.second)
 		{
@@ -303,6 +348,39 @@ class idm
 		return nullptr;
 	}
 
+	// Find ID without locking and access the object while it cannot be removed, returns func() result or {}
+	template <typename T, typename Type, typename F>
+	static auto read_id(u32 id, F&& func) -> decltype(func(std::declval<map_data&>()))
+	{
+		const auto slot = find_slot<T, Type>(id);
+
+		if (!slot)
+		{
+			return {};
+		}
+
+		// Removal waits for the readers after clearing the tag
+		slot->readers++;
+
+		const u64 tag = slot->tag;
+
+		decltype(func(std::declval<map_data&>())) result{};
+
+		if (tag >> 32)
+		{
+			if (std::is_same<T, Type>::value || (tag >> 32) - 1 == get_type<Type>())
+			{
+				if (!id_manager::id_traits<Type>::invl_range.second || static_cast<u32>(tag) == id)
+				{
+					result = func(*slot);
+				}
+			}
+		}
+
+		slot->readers--;
+		return result;
+	}
+
 	// Allocate new ID and assign the object from the provider()
 	template <typename T, typename Type, typename F>
 	static map_data* create_id(F&& provider)
@@ -317,13 +395,14 @@ class idm
 
 		auto& map = g_fxo->get<id_manager::id_map<T>>();
 
-		if (auto* place = allocate_id(map.vec, get_type<Type>(), traits::base, traits::step, traits::count, traits::invl_range))
+		if (auto* place = allocate_id(map, get_type<Type>(), traits::base, traits::step, traits::count, traits::invl_range))
 		{
 			// Get object, store it
 			place->second = provider();
 
 			if (place->second)
 			{
+				place->publish();
 				return place;
 			}
 		}
@@ -331,14 +410,37 @@ class idm
 		return nullptr;
 	}
 
+	// Hide the object from lock-free readers and take it (requires the global mutex)
+	static std::shared_ptr<void> release(map_data* found)
+	{
+		static_cast<id_manager::id_slot*>(found)->unpublish();
+		return std::move(found->second);
+	}
+
 public:
 
 	// Remove all objects of a type
 	template <typename T>
 	static inline void clear()
 	{
-		std::lock_guard lock(id_manager::g_mutex);
-		g_fxo->get<id_manager::id_map<T>>().vec.clear();
+		std::vector<std::shared_ptr<void>> objects;
+		{
+			std::lock_guard lock(id_manager::g_mutex);
+
+			auto& map = g_fxo->get<id_manager::id_map<T>>();
+
+			for (u32 i = 0; i < map.size; i++)
+			{
+				if (map.slots[i].second)
+				{
+					objects.emplace_back(release(&map.slots[i]));
+				}
+
+				map.slots[i].first = {};
+			}
+
+			map.size = 0;
+		}
 	}
 
 	// Get last ID (updated in create_id/allocate_id)
@@ -414,13 +516,14 @@ public:
 		return nullptr;
 	}
 
-	// Check the ID
+	// Check the ID (lock-free)
 	template <typename T, typename Get = T>
 	static inline Get* check(u32 id)
 	{
-		reader_lock lock(id_manager::g_mutex);
-
-		return check_unlocked<T, Get>(id);
+		return read_id<T, Get>(id, [](map_data& data)
+		{
+			return static_cast<Get*>(data.second.get());
+		});
 	}
 
 	// Check the ID, access object under shared lock
@@ -466,20 +569,14 @@ public:
 		return std::static_pointer_cast<Get>(found->second);
 	}
 
-	// Get the object
+	// Get the object (lock-free)
 	template <typename T, typename Get = T>
 	static inline std::shared_ptr<Get> get(u32 id)
 	{
-		reader_lock lock(id_manager::g_mutex);
-
-		const auto found = find_id<T, Get>(id);
-
-		if (found == nullptr) [[unlikely]]
+		return read_id<T, Get>(id, [](map_data& data)
 		{
-			return nullptr;
-		}
-
-		return std::static_pointer_cast<Get>(found->second);
+			return std::static_pointer_cast<Get>(data.second);
+		});
 	}
 
 	// Get the object, access object under reader lock
@@ -518,8 +615,12 @@ public:
 
 		u32 result = 0;
 
-		for (auto& id : g_fxo->get<id_manager::id_map<T>>().vec)
+		auto& map = g_fxo->get<id_manager::id_map<T>>();
+
+		for (u32 i = 0, size = map.size; i < size; i++)
 		{
+			auto& id = map.slots[i];
+
 			if (id.second)
 			{
 				if (std::is_same<T, Get>::value || id.first.type() == get_type<Get>())
@@ -544,8 +645,12 @@ public:
 
 		reader_lock lock(id_manager::g_mutex);
 
-		for (auto& id : g_fxo->get<id_manager::id_map<T>>().vec)
+		auto& map = g_fxo->get<id_manager::id_map<T>>();
+
+		for (u32 i = 0, size = map.size; i < size; i++)
 		{
+			auto& id = map.slots[i];
+
 			if (auto ptr = static_cast<object_type*>(id.second.get()))
 			{
 				if (std::is_same<T, Get>::value || id.first.type() == get_type<Get>())
@@ -571,7 +676,7 @@ public:
 
 			if (const auto found = find_id<T, Get>(id))
 			{
-				ptr = std::move(found->second);
+				ptr = release(found);
 			}
 			else
 			{
@@ -593,7 +698,7 @@ public:
 			if (const auto found = find_id<T, Get>(id); found &&
 				(!found->second.owner_before(sptr) && !sptr.owner_before(found->second)))
 			{
-				ptr = std::move(found->second);
+				ptr = release(found);
 			}
 			else
 			{
@@ -614,7 +719,7 @@ public:
 
 			if (const auto found = find_id<T, Get>(id))
 			{
-				ptr = std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second)));
+				ptr = std::static_pointer_cast<Get>(release(found));
 			}
 		}
 
@@ -634,7 +739,7 @@ public:
 			if constexpr (std::is_void_v<FRT>)
 			{
 				func(*_ptr);
-				return std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second)));
+				return std::static_pointer_cast<Get>(release(found));
 			}
 			else
 			{
@@ -646,7 +751,7 @@ public:
 					return {{found->second, _ptr}, std::move(ret)};
 				}
 
-				return {std::static_pointer_cast<Get>(::as_rvalue(std::move(found->second))), std::move(ret)};
+				return {std::static_pointer_cast<Get>(release(found)), std::move(ret)};
 			}
 		}
 
@@ -294,6 +294,202 @@ namespace
 		}
 	}
 
+	/**
+	 * Scalar reference for the gather kernels, used by AUDIT to check their output in debug builds.
+	 * Compares the first size bytes of each destination element with the source element, swapping swap_size byte units.
+	 */
+	template <u32 swap_size>
+	bool verify_strided_copy(const void* dst, const void* src, u32 vertex_count, u32 size, u32 dst_stride, u32 src_stride)
+	{
+		const auto dst_ptr = static_cast<const u8*>(dst);
+		const auto src_ptr = static_cast<const u8*>(src);
+
+		for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+		{
+			for (u32 i = 0; i < size; ++i)
+			{
+				const u32 from = swap_size ? (i & ~(swap_size - 1)) + (swap_size - 1 - (i & (swap_size - 1))) : i;
+
+				if (dst_ptr[vertex * dst_stride + i] != src_ptr[vertex * src_stride + from])
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	/**
+	 * Copy fixed size attributes from a strided source into a packed destination using AVX2 gathers, 8 vertices per iteration.
+	 * Each destination element (1 to 4 dwords) is read from the start of the source element, as the SSE paths do.
+	 * Returns the number of vertices written, the remaining ones are left to the caller.
+	 */
+	template <u32 swap_size>
+	AVX2_FUNC u32 stream_data_to_memory_gather_avx2(void* dst, const void* src, u32 vertex_count, u8 dst_stride, u32 src_stride)
+	{
+		if (!dst_stride || (dst_stride & 3) || dst_stride > 16 || (src_stride && src_stride < dst_stride))
+		{
+			return 0;
+		}
+
+		const u32 dwords = dst_stride / 4;
+		const u32 iterations = vertex_count / 8;
+
+		// Byte offsets of every destination dword relative to the first vertex of the batch
+		__m256i offsets[4];
+
+		for (u32 g = 0; g < dwords; ++g)
+		{
+			alignas(32) s32 lanes[8];
+
+			for (u32 j = 0, k = g * 8; j < 8; ++j, ++k)
+			{
+				lanes[j] = static_cast<s32>((k / dwords) * src_stride + (k % dwords) * 4);
+			}
+
+			offsets[g] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+		}
+
+		__m256i mask = _mm256_setzero_si256();
+
+		if constexpr (swap_size == 4)
+		{
+			mask = _mm256_broadcastsi128_si256(_mm_set_epi8(
+				0xC, 0xD, 0xE, 0xF,
+				0x8, 0x9, 0xA, 0xB,
+				0x4, 0x5, 0x6, 0x7,
+				0x0, 0x1, 0x2, 0x3));
+		}
+		else if constexpr (swap_size == 2)
+		{
+			mask = _mm256_broadcastsi128_si256(_mm_set_epi8(
+				0xE, 0xF, 0xC, 0xD,
+				0xA, 0xB, 0x8, 0x9,
+				0x6, 0x7, 0x4, 0x5,
+				0x2, 0x3, 0x0, 0x1));
+		}
+
+		auto src_ptr = static_cast<const char*>(src);
+		auto dst_ptr = static_cast<__m256i*>(dst);
+
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			for (u32 g = 0; g < dwords; ++g)
+			{
+				__m256i vector = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src_ptr), offsets[g], 1);
+
+				if constexpr (swap_size != 0)
+				{
+					vector = _mm256_shuffle_epi8(vector, mask);
+				}
+
+				_mm256_storeu_si256(dst_ptr++, vector);
+			}
+
+			src_ptr += src_stride * 8;
+		}
+
+		AUDIT(verify_strided_copy<swap_size>(dst, src, iterations * 8, dst_stride, dst_stride, src_stride));
+		return iterations * 8;
+	}
+
+	/**
+	 * Copy 3 byte attributes into 4 byte destination elements using AVX2 gathers, 8 vertices per iteration.
+	 * The fourth destination byte is kept. A whole dword is read from every source element, so the last vertex is always left to the caller.
+	 * Returns the number of vertices written.
+	 */
+	AVX2_FUNC u32 stream_data_to_memory_u8_3_avx2(void* dst, const void* src, u32 vertex_count, u32 src_stride)
+	{
+		const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(src_stride));
+		const __m256i mask = _mm256_set1_epi32(0xFFFFFF);
+		const u32 iterations = (vertex_count - 1) / 8;
+
+		auto src_ptr = static_cast<const char*>(src);
+		auto dst_ptr = static_cast<__m256i*>(dst);
+
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			const __m256i vector = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src_ptr), offsets, 1);
+			_mm256_storeu_si256(dst_ptr, _mm256_blendv_epi8(_mm256_loadu_si256(dst_ptr), vector, mask));
+
+			dst_ptr++;
+			src_ptr += src_stride * 8;
+		}
+
+		AUDIT(verify_strided_copy<0>(dst, src, iterations * 8, 3, 4, src_stride));
+		return iterations * 8;
+	}
+
+	/**
+	 * Decode CMP vectors to RGBA16 (see decode_cmp_vector), 8 vertices per iteration into a packed destination.
+	 * Returns the number of vertices written, the remaining ones are left to the caller.
+	 */
+	template <bool swap>
+	bool verify_cmp_vectors(const void* dst, const void* src, u32 vertex_count, u32 src_stride)
+	{
+		for (u32 vertex = 0; vertex < vertex_count; ++vertex)
+		{
+			u32 src_value;
+			std::memcpy(&src_value, static_cast<const char*>(src) + vertex * src_stride, sizeof(u32));
+
+			if (swap) src_value = stx::se_storage<u32>::swap(src_value);
+
+			if (std::memcmp(static_cast<const u16*>(dst) + vertex * 4, decode_cmp_vector(src_value).data(), 8) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	template <bool swap>
+	AVX2_FUNC u32 decode_cmp_vectors_avx2(void* dst, const void* src, u32 vertex_count, u32 src_stride)
+	{
+		const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(src_stride));
+		const __m256i mask = _mm256_broadcastsi128_si256(_mm_set_epi8(
+			0xC, 0xD, 0xE, 0xF,
+			0x8, 0x9, 0xA, 0xB,
+			0x4, 0x5, 0x6, 0x7,
+			0x0, 0x1, 0x2, 0x3));
+
+		const __m256i mask_11 = _mm256_set1_epi32(0x7FF);
+		const __m256i w = _mm256_set1_epi32(1 << 16);
+		const u32 iterations = vertex_count / 8;
+
+		auto src_ptr = static_cast<const char*>(src);
+		auto dst_ptr = static_cast<__m256i*>(dst);
+
+		for (u32 i = 0; i < iterations; ++i)
+		{
+			__m256i vector = _mm256_i32gather_epi32(reinterpret_cast<const int*>(src_ptr), offsets, 1);
+
+			if constexpr (swap)
+			{
+				vector = _mm256_shuffle_epi8(vector, mask);
+			}
+
+			const __m256i x = _mm256_slli_epi32(_mm256_and_si256(vector, mask_11), 5);
+			const __m256i y = _mm256_slli_epi32(_mm256_and_si256(_mm256_srli_epi32(vector, 11), mask_11), 5);
+			const __m256i z = _mm256_slli_epi32(_mm256_srli_epi32(vector, 22), 6);
+
+			// Interleave (X | Y << 16) and (Z | W << 16) into one qword per vertex
+			const __m256i xy = _mm256_or_si256(x, _mm256_slli_epi32(y, 16));
+			const __m256i zw = _mm256_or_si256(z, w);
+			const __m256i lo = _mm256_unpacklo_epi32(xy, zw);
+			const __m256i hi = _mm256_unpackhi_epi32(xy, zw);
+
+			_mm256_storeu_si256(dst_ptr++, _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256(dst_ptr++, _mm256_permute2x128_si256(lo, hi, 0x31));
+
+			src_ptr += src_stride * 8;
+		}
+
+		AUDIT(verify_cmp_vectors<swap>(dst, src, iterations * 8, src_stride));
+		return iterations * 8;
+	}
+
 	inline void stream_data_to_memory_swapped_u32_non_continuous(void *dst, const void *src, u32 vertex_count, u8 dst_stride, u8 src_stride)
 	{
 		const __m128i mask = _mm_set_epi8(
@@ -305,6 +501,14 @@ namespace
 		auto src_ptr = static_cast<const char*>(src);
 		auto dst_ptr = static_cast<char*>(dst);
 
+		if (s_use_avx2 && vertex_count >= 8)
+		{
+			const u32 done = stream_data_to_memory_gather_avx2<4>(dst_ptr, src_ptr, vertex_count, dst_stride, src_stride);
+			src_ptr += done * src_stride;
+			dst_ptr += done * dst_stride;
+			vertex_count -= done;
+		}
+
 		//Count vertices to copy
 		const bool is_128_aligned = !((dst_stride | src_stride) & 15);
 
@@ -373,6 +577,14 @@ namespace
 		auto src_ptr = static_cast<const char*>(src);
 		auto dst_ptr = static_cast<char*>(dst);
 
+		if (s_use_avx2 && vertex_count >= 8)
+		{
+			const u32 done = stream_data_to_memory_gather_avx2<2>(dst_ptr, src_ptr, vertex_count, dst_stride, src_stride);
+			src_ptr += done * src_stride;
+			dst_ptr += done * dst_stride;
+			vertex_count -= done;
+		}
+
 		const bool is_128_aligned = !((dst_stride | src_stride) & 15);
 
 		u32 min_block_size = std::min(src_stride, dst_stride);
@@ -437,6 +649,14 @@ namespace
 		{
 			case 4:
 			{
+				if (s_use_avx2 && dst_stride == 4 && vertex_count >= 8)
+				{
+					const u32 done = stream_data_to_memory_gather_avx2<0>(dst_ptr, src_ptr, vertex_count, dst_stride, src_stride);
+					src_ptr += done * src_stride;
+					dst_ptr += done * dst_stride;
+					vertex_count -= done;
+				}
+
 				//Read one dword every iteration
 				for (u32 vertex = 0; vertex < vertex_count; ++vertex)
 				{
@@ -450,6 +670,14 @@ namespace
 			}
 			case 3:
 			{
+				if (s_use_avx2 && dst_stride == 4 && src_stride && vertex_count > 8)
+				{
+					const u32 done = stream_data_to_memory_u8_3_avx2(dst_ptr, src_ptr, vertex_count, src_stride);
+					src_ptr += done * src_stride;
+					dst_ptr += done * dst_stride;
+					vertex_count -= done;
+				}
+
 				//Read one word and one byte
 				for (u32 vertex = 0; vertex < vertex_count; ++vertex)
 				{
@@ -546,19 +774,34 @@ namespace
 
 		if (src_vertex_count == vertex_count)
 		{
+			auto src_ptr = static_cast<const char*>(raw_src);
+			auto dst_ptr = static_cast<char*>(raw_dst);
+			u32 count = vertex_count;
+
+			// Elements filling the whole destination dwords can use the same gathers as the streaming paths
+			if (s_use_avx2 && count >= 8 && attribute_size * sizeof(T) == dst_stride)
+			{
+				constexpr u32 swap_size = std::is_same_v<U, be_t<u16>> ? 2 : std::is_same_v<U, be_t<u32>> ? 4 : 0;
+
+				const u32 done = stream_data_to_memory_gather_avx2<swap_size>(dst_ptr, src_ptr, count, dst_stride, src_stride);
+				src_ptr += done * src_stride;
+				dst_ptr += done * dst_stride;
+				count -= done;
+			}
+
 			switch (attribute_size)
 			{
 			case 1:
-				copy_whole_attribute_array_impl<U, T, 1>(raw_dst, raw_src, dst_stride, src_stride, vertex_count);
+				copy_whole_attribute_array_impl<U, T, 1>(dst_ptr, src_ptr, dst_stride, src_stride, count);
 				break;
 			case 2:
-				copy_whole_attribute_array_impl<U, T, 2>(raw_dst, raw_src, dst_stride, src_stride, vertex_count);
+				copy_whole_attribute_array_impl<U, T, 2>(dst_ptr, src_ptr, dst_stride, src_stride, count);
 				break;
 			case 3:
-				copy_whole_attribute_array_impl<U, T, 3>(raw_dst, raw_src, dst_stride, src_stride, vertex_count);
+				copy_whole_attribute_array_impl<U, T, 3>(dst_ptr, src_ptr, dst_stride, src_stride, count);
 				break;
 			case 4:
-				copy_whole_attribute_array_impl<U, T, 4>(raw_dst, raw_src, dst_stride, src_stride, vertex_count);
+				copy_whole_attribute_array_impl<U, T, 4>(dst_ptr, src_ptr, dst_stride, src_stride, count);
 				break;
 			}
 		}
@@ -666,7 +909,16 @@ void write_vertex_array_data_to_buffer(gsl::span<std::byte> raw_dst_span, gsl::s
 	case rsx::vertex_base_type::cmp:
 	{
 		gsl::span<u16> dst_span = as_span_workaround<u16>(raw_dst_span);
-		for (u32 i = 0; i < count; ++i)
+		u32 i = 0;
+
+		if (s_use_avx2 && dst_stride == 8 && count >= 8)
+		{
+			i = swap_endianness ?
+				decode_cmp_vectors_avx2<true>(dst_span.data(), src_ptr.data(), count, attribute_src_stride) :
+				decode_cmp_vectors_avx2<false>(dst_span.data(), src_ptr.data(), count, attribute_src_stride);
+		}
+
+		for (; i < count; ++i)
 		{
 			u32 src_value;
 			memcpy(&src_value, src_ptr.subspan(attribute_src_stride * i).data(), sizeof(u32));
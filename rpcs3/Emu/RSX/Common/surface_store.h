@@ -7,7 +7,7 @@
 
 #include "util/asm.hpp"
 
-#include <unordered_map>
+#include <map>
 
 namespace rsx
 {
@@ -18,6 +18,76 @@ namespace rsx
 		usz get_packed_pitch(surface_color_format format, u32 width);
 	}
 
+	/**
+	 * Address-ordered surface table.
+	 * Overlap queries only visit entries whose base address lies within the widest span ever stored
+	 * below the query range, instead of walking the whole table.
+	 */
+	template <typename Traits>
+	class surface_storage_index
+	{
+		using surface_storage_type = typename Traits::surface_storage_type;
+		using map_type = std::map<u32, surface_storage_type>;
+
+		map_type m_data;
+
+		// Upper bound of the memory range length of any stored surface, only reset on clear
+		u32 m_max_span = 0;
+
+	public:
+		using iterator = typename map_type::iterator;
+
+		iterator begin() { return m_data.begin(); }
+		iterator end() { return m_data.end(); }
+		iterator find(u32 address) { return m_data.find(address); }
+		iterator erase(iterator it) { return m_data.erase(it); }
+		usz erase(u32 address) { return m_data.erase(address); }
+		bool empty() const { return m_data.empty(); }
+		usz size() const { return m_data.size(); }
+
+		void clear()
+		{
+			m_data.clear();
+			m_max_span = 0;
+		}
+
+		void insert(u32 address, surface_storage_type&& storage)
+		{
+			update_span(Traits::get(storage)->get_memory_range());
+			m_data.insert_or_assign(address, std::move(storage));
+		}
+
+		// Must be called when a stored surface changes its memory footprint in place
+		void update_span(const rsx::address_range& range)
+		{
+			m_max_span = std::max(m_max_span, range.length());
+		}
+
+		// Calls func(address, storage) for every stored surface overlapping range in the same memory partition as range.start
+		template <typename F>
+		void for_each_overlap(const rsx::address_range& range, F&& func)
+		{
+			if (m_data.empty())
+			{
+				return;
+			}
+
+			const bool local = range.start >= constants::local_mem_base;
+			const u32 partition_start = local ? constants::local_mem_base : 0;
+			const u32 partition_end = local ? 0xffffffffu : constants::local_mem_base - 1;
+			const u32 scan_start = (range.start - partition_start >= m_max_span) ? range.start - m_max_span + 1 : partition_start;
+			const u32 scan_end = std::min(range.end, partition_end);
+
+			for (auto it = m_data.lower_bound(scan_start); it != m_data.end() && it->first <= scan_end; ++it)
+			{
+				if (range.overlaps(Traits::get(it->second)->get_memory_range()))
+				{
+					func(it->first, it->second);
+				}
+			}
+		}
+	};
+
 	template<typename Traits>
 	struct surface_store
 	{
@@ -43,10 +113,14 @@ namespace rsx
 		using surface_type = typename Traits::surface_type;
 		using command_list_type = typename Traits::command_list_type;
 		using surface_overlap_info = surface_overlap_info_t<surface_type>;
+		using surface_storage_index_type = surface_storage_index<Traits>;
 
 	protected:
-		std::unordered_map<u32, surface_storage_type> m_render_targets_storage = {};
-		std::unordered_map<u32, surface_storage_type> m_depth_stencil_storage = {};
+		surface_storage_index_type m_render_targets_storage = {};
+		surface_storage_index_type m_depth_stencil_storage = {};
+
+		// Scratch list for intersect_surface_region, kept to avoid reallocating on every bind
+		std::vector<std::pair<u32, surface_type>> m_intersect_list;
 
 		rsx::address_range m_render_targets_memory_range;
 		rsx::address_range m_depth_stencil_memory_range;
@@ -86,7 +160,7 @@ namespace rsx
 			auto insert_new_surface = [&](
 				u32 new_address,
 				deferred_clipped_region<surface_type>& region,
-				std::unordered_map<u32, surface_storage_type>& data)
+				surface_storage_index_type& data)
 			{
 				surface_storage_type sink;
 				surface_type invalidated = 0;
@@ -152,7 +226,7 @@ namespace rsx
 
 				ensure(region.target == Traits::get(sink));
 				orphaned_surfaces.push_back(region.target);
-				data[new_address] = std::move(sink);
+				data.insert(new_address, std::move(sink));
 			};
 
 			// Define incoming region
@@ -239,91 +313,60 @@ namespace rsx
 		template <bool is_depth_surface>
 		void intersect_surface_region(command_list_type cmd, u32 address, surface_type new_surface, surface_type prev_surface)
 		{
-			auto scan_list = [&new_surface, address](const rsx::address_range& mem_range,
-				std::unordered_map<u32, surface_storage_type>& data) -> std::vector<std::pair<u32, surface_type>>
+			auto& surface_info = m_intersect_list;
+			surface_info.clear();
+
+			auto scan_list = [&new_surface, &surface_info, address](const rsx::address_range& mem_range,
+				surface_storage_index_type& data)
 			{
-				std::vector<std::pair<u32, surface_type>> result;
-				for (const auto &e : data)
+				data.for_each_overlap(mem_range, [&](u32 this_address, surface_storage_type& storage)
 				{
-					auto surface = Traits::get(e.second);
+					auto surface = Traits::get(storage);
 
 					if (new_surface->last_use_tag >= surface->last_use_tag ||
 						new_surface == surface ||
-						address == e.first)
+						address == this_address)
 					{
 						// Do not bother synchronizing with uninitialized data
-						continue;
-					}
-
-					// Memory partition check
-					if (mem_range.start >= constants::local_mem_base)
-					{
-						if (e.first < constants::local_mem_base) continue;
-					}
-					else
-					{
-						if (e.first >= constants::local_mem_base) continue;
+						return;
 					}
 
 					// Pitch check
 					if (!rsx::pitch_compatible(surface, new_surface))
 					{
-						continue;
+						return;
 					}
 
-					// Range check
-					const rsx::address_range this_range = surface->get_memory_range();
-					if (!this_range.overlaps(mem_range))
-					{
-						continue;
-					}
-
-					result.push_back({ e.first, surface });
-				}
-
-				return result;
+					surface_info.push_back({ this_address, surface });
+				});
 			};
 
+			// Range and memory partition checks are handled by the index
 			const rsx::address_range mem_range = new_surface->get_memory_range();
-			auto list1 = scan_list(mem_range, m_render_targets_storage);
-			auto list2 = scan_list(mem_range, m_depth_stencil_storage);
+			scan_list(mem_range, m_render_targets_storage);
 
-			if (prev_surface)
+			if constexpr (!is_depth_surface)
 			{
-				// Append the previous removed surface to the intersection list
-				if constexpr (is_depth_surface)
+				if (prev_surface)
 				{
-					list2.push_back({ address, prev_surface });
-				}
-				else
-				{
-					list1.push_back({ address, prev_surface });
+					// Append the previous removed surface to the intersection list
+					surface_info.push_back({ address, prev_surface });
 				}
 			}
-			else
+
+			scan_list(mem_range, m_depth_stencil_storage);
+
+			if constexpr (is_depth_surface)
 			{
-				if (list1.empty() && list2.empty())
+				if (prev_surface)
 				{
-					return;
+					surface_info.push_back({ address, prev_surface });
 				}
 			}
 
-			std::vector<std::pair<u32, surface_type>> surface_info;
-			if (list1.empty())
-			{
-				surface_info = std::move(list2);
-			}
-			else if (list2.empty())
-			{
-				surface_info = std::move(list1);
-			}
-			else
+			if (surface_info.empty())
 			{
-				const auto reserve = list1.size() + list2.size();
-				surface_info = std::move(list1);
-				surface_info.reserve(reserve);
-
-				for (const auto& e : list2) surface_info.push_back(e);
+				return;
 			}
 
 			// TODO: Modify deferred_clip_region::direct_copy() to take a few more things into account!
@@ -407,18 +450,18 @@ namespace rsx
 				{
 					// This has been 'swallowed' by the new surface and can be safely freed
 					auto &storage = surface->is_depth_surface() ? m_depth_stencil_storage : m_render_targets_storage;
-					auto &object = storage[e.first];
+					const auto found = storage.find(e.first);
 
 					ensure(!src_offset.x);
 					ensure(!src_offset.y);
-					ensure(object);
+					ensure(found != storage.end() && found->second);
 					if (!surface->old_contents.empty()) [[unlikely]]
 					{
 						surface->read_barrier(cmd);
 					}
 
-					invalidate(object);
-					storage.erase(e.first);
+					invalidate(found->second);
+					storage.erase(found);
 					superseded_surfaces.push_back(surface);
 				}
 			}
@@ -442,7 +485,7 @@ namespace rsx
 			bool store = true;
 
 			address_range *storage_bounds;
-			std::unordered_map<u32, surface_storage_type> *primary_storage, *secondary_storage;
+			surface_storage_index_type *primary_storage, *secondary_storage;
 			if constexpr (depth)
 			{
 				primary_storage = &m_depth_stencil_storage;
@@ -466,9 +509,14 @@ namespace rsx
 				if (Traits::surface_matches_properties(surface, format, width, height, antialias))
 				{
 					if (pitch_compatible)
+					{
 						Traits::notify_surface_persist(surface);
+					}
 					else
+					{
 						Traits::invalidate_surface_contents(command_list, Traits::get(surface), address, pitch);
+						primary_storage->update_span(Traits::get(surface)->get_memory_range());
+					}
 
 					Traits::prepare_surface_for_drawing(command_list, Traits::get(surface));
 					new_surface = Traits::get(surface);
@@ -593,7 +641,7 @@ namespace rsx
 			if (store)
 			{
 				// New surface was found among invalidated surfaces or created from scratch
-				(*primary_storage)[address] = std::move(new_surface_storage);
+				primary_storage->insert(address, std::move(new_surface_storage));
 			}
 
 			ensure(!old_surface_storage);
@@ -828,20 +876,17 @@ namespace rsx
 
 			const auto test_range = utils::address_range::start_length(texaddr, (required_pitch * required_height) - (required_pitch - surface_internal_pitch));
 
-			auto process_list_function = [&](std::unordered_map<u32, surface_storage_type>& data, bool is_depth)
+			auto process_list_function = [&](surface_storage_index_type& data, bool is_depth)
 			{
-				for (auto& tex_info : data)
+				data.for_each_overlap(test_range, [&](u32, surface_storage_type& storage)
 				{
-					const auto range = tex_info.second->get_memory_range();
-					if (!range.overlaps(test_range))
-						continue;
-
-					auto surface = tex_info.second.get();
+					const auto range = storage->get_memory_range();
+					auto surface = storage.get();
 					if (access == rsx::surface_access::transfer && surface->write_through())
-						continue;
+						return;
 
 					if (!rsx::pitch_compatible(surface, required_pitch, required_height))
-						continue;
+						return;
 
 					surface_overlap_info info;
 					u32 width, height;
@@ -861,7 +906,7 @@ namespace rsx
 						if (info.dst_area.x >= required_width || info.dst_area.y >= required_height) [[unlikely]]
 						{
 							// Out of bounds
-							continue;
+							return;
 						}
 
 						info.src_area.x = 0;
@@ -880,7 +925,7 @@ namespace rsx
 						{
 							// Region lies outside the actual texture area, but inside the 'tile'
 							// In this case, a small region lies to the top-left corner, partially occupying the  target
-							continue;
+							return;
 						}
 
 						info.dst_area.x = 0;
@@ -893,7 +938,7 @@ namespace rsx
 					if (surface->memory_barrier(cmd, access); !surface->test())
 					{
 						dirty.emplace_back(range.start, is_depth);
-						continue;
+						return;
 					}
 
 					info.is_clipped = (width < required_width || height < required_height);
@@ -912,7 +957,7 @@ namespace rsx
 					}
 
 					result.push_back(info);
-				}
+				});
 			};
 
 			// Range test helper to quickly discard blocks
@@ -1086,23 +1131,14 @@ namespace rsx
 
 		void invalidate_range(const rsx::address_range& range)
 		{
-			for (auto &rtt : m_render_targets_storage)
+			auto invalidate_surface = [](u32, surface_storage_type& storage)
 			{
-				if (range.overlaps(rtt.second->get_memory_range()))
-				{
-					rtt.second->clear_rw_barrier();
-					rtt.second->state_flags |= rsx::surface_state_flags::erase_bkgnd;
-				}
-			}
+				storage->clear_rw_barrier();
+				storage->state_flags |= rsx::surface_state_flags::erase_bkgnd;
+			};
 
-			for (auto &ds : m_depth_stencil_storage)
-			{
-				if (range.overlaps(ds.second->get_memory_range()))
-				{
-					ds.second->clear_rw_barrier();
-					ds.second->state_flags |= rsx::surface_state_flags::erase_bkgnd;
-				}
-			}
+			m_render_targets_storage.for_each_overlap(range, invalidate_surface);
+			m_depth_stencil_storage.for_each_overlap(range, invalidate_surface);
 		}
 
 		bool check_memory_usage(u64 max_safe_memory) const
@@ -1120,7 +1156,7 @@ namespace rsx
 
 		bool handle_memory_pressure(command_list_type cmd, problem_severity /*severity*/)
 		{
-			auto process_list_function = [&](std::unordered_map<u32, surface_storage_type>& data)
+			auto process_list_function = [&](surface_storage_index_type& data)
 			{
 				for (auto It = data.begin(); It != data.end();)
 				{
@@ -236,7 +236,18 @@ namespace rsx
 			case detail_level::minimal: [[fallthrough]];
 			case detail_level::low: m_titles.set_text(""); break;
 			case detail_level::medium: m_titles.set_text(fmt::format("\n\n%s", title1_medium)); break;
-			case detail_level::high: m_titles.set_text(fmt::format("\n\n%s\n\n\n\n\n\n%s", title1_high, title2)); break;
+			case detail_level::high:
+			{
+				std::string titles = fmt::format("\n\n%s\n\n\n\n\n\n%s", title1_high, title2);
+
+				if (g_cfg.core.perf_report)
+				{
+					fmt::append(titles, "\n\n\n%s", title3);
+				}
+
+				m_titles.set_text(titles);
+				break;
+			}
 			}
 			m_titles.auto_resize();
 			m_titles.refresh();
@@ -455,6 +466,13 @@ namespace rsx
 
 						m_total_threads = utils::cpu_stats::get_thread_count();
 
+						if (g_cfg.core.perf_report)
+						{
+							// Events of the last update interval
+							m_events = perf_stat_base::query(perf_stat_window::overlay, true);
+							m_events.resize(std::min(m_events.size(), max_events));
+						}
+
 						[[fallthrough]];
 					}
 					case detail_level::medium:
@@ -544,6 +562,17 @@ namespace rsx
 					                         "%s\n"
 					                         " RSX   : %02u %%",
 					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load);
+
+					if (g_cfg.core.perf_report)
+					{
+						fmt::append(perf_text, "\n\n%s", std::string(title3.size(), ' '));
+
+						for (const auto& event : m_events)
+						{
+							fmt::append(perf_text, "\n %s: %.1f/%.1fus, %.2fms", event.name, event.p50 / 1000., event.p99 / 1000., event.total / 1000'000.);
+						}
+					}
+
 					break;
 				}
 				}
@@ -3,6 +3,7 @@
 #include "overlays.h"
 #include "util/cpu_stats.hpp"
 #include "Emu/system_config_types.h"
+#include "Emu/perf_meter.hpp"
 
 namespace rsx
 {
@@ -16,7 +17,7 @@ namespace rsx
 			// minimal - fps
 			// low - fps, total cpu usage
 			// medium - fps, detailed cpu usage
-			// high - fps, frametime, detailed cpu usage, thread number, rsx load
+			// high - fps, frametime, detailed cpu usage, thread number, rsx load, top events (with performance report enabled)
 			detail_level m_detail{};
 
 			screen_quadrant m_quadrant{};
@@ -57,6 +58,7 @@ namespace rsx
 			const std::string title1_medium{ "CPU Utilization:" };
 			const std::string title1_high{ "Host Utilization (CPU):" };
 			const std::string title2{ "Guest Utilization (PS3):" };
+			const std::string title3{ "Top Events (p50/p99, total):" };
 
 			f32 m_fps{0};
 			f32 m_frametime{0};
@@ -77,6 +79,11 @@ namespace rsx
 			f32 m_rsx_usage{0};
 			u32 m_rsx_load{0};
 
+			// Number of events shown in the high detail level
+			static constexpr usz max_events = 5;
+
+			std::vector<perf_stat_summary> m_events;
+
 			void reset_transform(label& elm, u16 bottom_margin = 0) const;
 			void reset_transforms();
 			void reset_body(u16 bottom_margin);
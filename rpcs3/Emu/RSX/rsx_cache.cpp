@@ -0,0 +1,184 @@
+#include "stdafx.h"
+#include "rsx_cache.h"
+
+#include "xxhash.h"
+
+namespace rsx
+{
+	struct pipeline_cache_archive_header
+	{
+		nse_t<u64> magic;
+		u32 version;
+		u32 pipeline_size;
+	};
+
+	struct pipeline_cache_record_header
+	{
+		u32 type;
+		u32 size;
+		u64 key;
+		u64 checksum; // XXH64 of the payload
+	};
+
+	static constexpr u64 c_archive_magic = "RSXPIPE\0"_u64;
+	static constexpr u32 c_archive_version = 1;
+
+	bool pipeline_cache_archive::open(const std::string& path, u32 pipeline_size)
+	{
+		close();
+
+		if (!m_file.open(path, fs::read + fs::write + fs::create))
+		{
+			return false;
+		}
+
+		const u64 file_size = m_file.size();
+
+		pipeline_cache_archive_header header{};
+
+		if (file_size < sizeof(header) || !m_file.read(header) || header.magic != c_archive_magic || header.version != c_archive_version || header.pipeline_size != pipeline_size)
+		{
+			if (file_size)
+			{
+				rsx_log.error("shaders_cache: Archive is not compatible with the current shader cache, discarding: %s", path);
+			}
+
+			header.magic = c_archive_magic;
+			header.version = c_archive_version;
+			header.pipeline_size = pipeline_size;
+
+			m_file.trunc(0);
+			m_file.seek(0);
+			m_file.write(header);
+		}
+
+		// Validate records, stop at the first broken one
+		m_view = fs::file_view(m_file);
+
+		if (m_view.size() != m_file.size())
+		{
+			close();
+			return false;
+		}
+
+		u64 pos = sizeof(header);
+
+		while (pos + sizeof(pipeline_cache_record_header) <= m_view.size())
+		{
+			pipeline_cache_record_header rec;
+			std::memcpy(&rec, m_view.data() + pos, sizeof(rec));
+
+			const u8* data = m_view.data() + pos + sizeof(rec);
+
+			if (rec.type - 1 >= std::size(m_keys) || rec.size > m_view.size() - pos - sizeof(rec) || XXH64(data, rec.size, 0) != rec.checksum)
+			{
+				break;
+			}
+
+			if (rec.type == static_cast<u32>(record_type::pipeline) && rec.size != pipeline_size)
+			{
+				break;
+			}
+
+			pos += sizeof(rec) + rec.size;
+		}
+
+		const u64 data_end = pos;
+
+		if (data_end != m_file.size())
+		{
+			rsx_log.warning("shaders_cache: Archive is truncated or broken (0x%x/0x%x bytes valid), repairing: %s", data_end, m_file.size(), path);
+
+			m_view.close();
+
+			if (!m_file.trunc(data_end))
+			{
+				close();
+				return false;
+			}
+
+			m_view = fs::file_view(m_file);
+		}
+
+		// Build the index
+		for (pos = sizeof(header); pos < data_end;)
+		{
+			pipeline_cache_record_header rec;
+			std::memcpy(&rec, m_view.data() + pos, sizeof(rec));
+
+			const blob entry{m_view.data() + pos + sizeof(rec), rec.size};
+
+			switch (static_cast<record_type>(rec.type))
+			{
+			case record_type::vertex_program: m_vertex_programs.emplace(rec.key, entry); break;
+			case record_type::fragment_program: m_fragment_programs.emplace(rec.key, entry); break;
+			case record_type::pipeline: m_pipelines.emplace_back(entry); break;
+			}
+
+			m_keys[rec.type - 1].emplace(rec.key);
+			pos += sizeof(rec) + rec.size;
+		}
+
+		// Reopen for appending only
+		return m_file.open(path, fs::read + fs::write + fs::append);
+	}
+
+	void pipeline_cache_archive::close()
+	{
+		m_file.close();
+		m_view.close();
+		m_vertex_programs.clear();
+		m_fragment_programs.clear();
+		m_pipelines.clear();
+
+		for (auto& keys : m_keys)
+		{
+			keys.clear();
+		}
+	}
+
+	bool pipeline_cache_archive::append(record_type type, u64 key, const void* data, u32 size)
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (!m_file || !m_keys[static_cast<u32>(type) - 1].emplace(key).second)
+		{
+			return false;
+		}
+
+		pipeline_cache_record_header rec;
+		rec.type = static_cast<u32>(type);
+		rec.size = size;
+		rec.key = key;
+		rec.checksum = XXH64(data, size, 0);
+
+		const fs::iovec_clone gather[2]
+		{
+			{&rec, sizeof(rec)},
+			{data, size}
+		};
+
+		// Single append, a partial write is dropped on the next open
+		m_file.write_gather(gather, 2);
+		return true;
+	}
+
+	bool pipeline_cache_archive::contains(record_type type, u64 key)
+	{
+		reader_lock lock(m_mutex);
+
+		return m_keys[static_cast<u32>(type) - 1].count(key) != 0;
+	}
+
+	const pipeline_cache_archive::blob* pipeline_cache_archive::find(record_type type, u64 key) const
+	{
+		const auto& map = type == record_type::vertex_program ? m_vertex_programs : m_fragment_programs;
+
+		if (const auto found = map.find(key); found != map.end())
+		{
+			return &found->second;
+		}
+
+		return nullptr;
+	}
+}
@@ -2,6 +2,7 @@
 #include "Utilities/File.h"
 #include "Utilities/lockless.h"
 #include "Utilities/Thread.h"
+#include "Utilities/mutex.h"
 #include "Common/ProgramStateCache.h"
 #include "Emu/System.h"
 #include "Common/texture_cache_checker.h"
@@ -10,6 +11,7 @@
 #include "rsx_utils.h"
 #include <chrono>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "util/vm.hpp"
 #include "util/sysinfo.hpp"
@@ -17,6 +19,63 @@
 
 namespace rsx
 {
+	// Append-only packed storage for the shader cache: a header followed by self-describing records.
+	// Every record carries a checksum of its payload, so a torn write is detected and dropped on open.
+	class pipeline_cache_archive
+	{
+	public:
+		enum class record_type : u32
+		{
+			vertex_program = 1,
+			fragment_program = 2,
+			pipeline = 3,
+		};
+
+		struct blob
+		{
+			const u8* data;
+			u32 size;
+		};
+
+	private:
+		fs::file m_file;
+		fs::file_view m_view;
+		shared_mutex m_mutex;
+
+		// Records present on open (pointing to the mapping)
+		std::unordered_map<u64, blob> m_vertex_programs;
+		std::unordered_map<u64, blob> m_fragment_programs;
+		std::vector<blob> m_pipelines;
+
+		// Keys of all records, including the ones appended after open
+		std::unordered_set<u64> m_keys[3];
+
+	public:
+		// Open (or reopen) the archive, the pipeline record size acts as a layout version
+		bool open(const std::string& path, u32 pipeline_size);
+
+		void close();
+
+		explicit operator bool() const
+		{
+			return m_file.operator bool();
+		}
+
+		// Append the record unless the key is already present, returns true if written
+		bool append(record_type type, u64 key, const void* data, u32 size);
+
+		// Check whether the record exists
+		bool contains(record_type type, u64 key);
+
+		// Find program blob loaded on open
+		const blob* find(record_type type, u64 key) const;
+
+		const std::vector<blob>& pipelines() const
+		{
+			return m_pipelines;
+		}
+	};
+
 	template <typename pipeline_storage_type, typename backend_storage>
 	class shaders_cache
 	{
@@ -51,10 +110,12 @@ namespace rsx
 			pipeline_storage_type pipeline_properties;
 		};
 
+		using record_type = pipeline_cache_archive::record_type;
+
 		std::string version_prefix;
 		std::string root_path;
 		std::string pipeline_class_name;
-		lf_fifo<std::unique_ptr<u8[]>, 100> fragment_program_data;
+		pipeline_cache_archive m_archive;
 
 		backend_storage& m_storage;
 
@@ -63,8 +124,7 @@ namespace rsx
 			return fmt::format("%s pipeline object %u of %u", index == 0 ? "Loading" : "Compiling", processed, entry_count);
 		}
 
-		void load_shaders(uint nb_workers, unpacked_type& unpacked, std::string& directory_path, std::vector<fs::dir_entry>& entries, u32 entry_count,
-		    shader_loading_dialog* dlg)
+		void load_shaders(uint nb_workers, unpacked_type& unpacked, u32 entry_count, shader_loading_dialog* dlg)
 		{
 			atomic_t<u32> processed(0);
 
@@ -74,26 +134,8 @@ namespace rsx
 				// Processed is incremented before work starts in order to avoid two workers working on the same shader
 				while (((pos = processed++) < stop_at) && !Emu.IsStopped())
 				{
-					fs::dir_entry tmp = entries[pos];
-
-					const auto filename = directory_path + "/" + tmp.name;
-					fs::file f(filename);
-
-					if (!f)
-					{
-						// Unexpected error, but avoid crash
-						continue;
-					}
-
-					if (f.size() != sizeof(pipeline_data))
-					{
-						rsx_log.error("Removing cached pipeline object %s since it's not binary compatible with the current shader cache", tmp.name.c_str());
-						fs::remove_file(filename);
-						continue;
-					}
-
 					pipeline_data pdata{};
-					f.read(&pdata, f.size());
+					std::memcpy(&pdata, m_archive.pipelines()[pos].data, sizeof(pdata));
 
 					auto entry = unpack(pdata);
 
@@ -113,6 +155,118 @@ namespace rsx
 			await_workers(nb_workers, 0, shader_load_worker, processed, entry_count, dlg);
 		}
 
+		std::string get_archive_path() const
+		{
+			return fmt::format("%s/%s-%s.pack", root_path, pipeline_class_name, version_prefix);
+		}
+
+		static u64 get_pipeline_key(const pipeline_data& data)
+		{
+			u64 state_hash = 0;
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
+			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
+			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_unnormalized_coords);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
+			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
+
+			u64 key = rpcs3::fnv_seed;
+			key = rpcs3::hash64(key, data.vertex_program_hash);
+			key = rpcs3::hash64(key, data.fragment_program_hash);
+			key = rpcs3::hash64(key, data.pipeline_storage_hash);
+			key = rpcs3::hash64(key, state_hash);
+			return key;
+		}
+
+		// Import the old layout (one file per pipeline and per program) into the archive, returns true if anything was imported
+		bool import_legacy_cache()
+		{
+			const std::string pipelines_path = root_path + "/pipelines";
+			const std::string directory_path = pipelines_path + "/" + pipeline_class_name + "/" + version_prefix;
+
+			fs::dir root(directory_path);
+
+			if (!root)
+			{
+				return false;
+			}
+
+			const auto read_raw = [](const std::string& path)
+			{
+				std::vector<u8> result;
+
+				if (fs::file f(path); f)
+				{
+					result = f.to_vector<u8>();
+				}
+
+				return result;
+			};
+
+			u32 count = 0;
+
+			for (auto&& tmp : root)
+			{
+				if (tmp.is_directory || tmp.size != sizeof(pipeline_data))
+				{
+					continue;
+				}
+
+				pipeline_data data{};
+
+				if (fs::file f(directory_path + "/" + tmp.name); !f || !f.read(data))
+				{
+					continue;
+				}
+
+				if (!m_archive.contains(record_type::vertex_program, data.vertex_program_hash))
+				{
+					const auto vp = read_raw(fmt::format("%s/raw/%llX.vp", root_path, data.vertex_program_hash));
+
+					if (vp.empty())
+					{
+						continue;
+					}
+
+					m_archive.append(record_type::vertex_program, data.vertex_program_hash, vp.data(), ::size32(vp));
+				}
+
+				if (!m_archive.contains(record_type::fragment_program, data.fragment_program_hash))
+				{
+					const auto fp = read_raw(fmt::format("%s/raw/%llX.fp", root_path, data.fragment_program_hash));
+
+					if (fp.empty())
+					{
+						continue;
+					}
+
+					m_archive.append(record_type::fragment_program, data.fragment_program_hash, fp.data(), ::size32(fp));
+				}
+
+				count += m_archive.append(record_type::pipeline, get_pipeline_key(data), &data, sizeof(data));
+			}
+
+			root.close();
+
+			rsx_log.success("shaders_cache: Imported %u pipeline objects from %s", count, directory_path);
+
+			// Raw programs are shared by all pipeline classes, only remove them once nothing refers to them
+			fs::remove_all(directory_path);
+			fs::remove_dir(pipelines_path + "/" + pipeline_class_name);
+
+			if (fs::remove_dir(pipelines_path))
+			{
+				fs::remove_all(root_path + "/raw");
+			}
+
+			return count != 0;
+		}
+
 		template <typename... Args>
 		void compile_shaders(uint nb_workers, unpacked_type& unpacked, u32 entry_count, shader_loading_dialog* dlg, Args&&... args)
 		{
@@ -211,34 +365,27 @@ namespace rsx
 				return;
 			}
 
-			std::string directory_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix;
+			fs::create_path(root_path);
 
-			fs::dir root = fs::dir(directory_path);
+			const std::string archive_path = get_archive_path();
 
-			if (!root)
+			if (!m_archive.open(archive_path, sizeof(pipeline_data)))
 			{
-				fs::create_path(directory_path);
-				fs::create_path(root_path + "/raw");
+				rsx_log.error("shaders_cache: Failed to open %s (%s)", archive_path, fs::g_tls_error);
 				return;
 			}
 
-			std::vector<fs::dir_entry> entries;
-
-			for (auto&& tmp : root)
+			if (import_legacy_cache() && !m_archive.open(archive_path, sizeof(pipeline_data)))
 			{
-				if (tmp.is_directory)
-					continue;
-
-				entries.push_back(tmp);
+				rsx_log.error("shaders_cache: Failed to reopen %s (%s)", archive_path, fs::g_tls_error);
+				return;
 			}
 
-			u32 entry_count = ::size32(entries);
+			u32 entry_count = ::size32(m_archive.pipelines());
 
 			if (!entry_count)
 				return;
 
-			root.rewind();
-
 			// Progress dialog
 			std::unique_ptr<shader_loading_dialog> fallback_dlg;
 			if (!dlg)
@@ -257,7 +404,7 @@ namespace rsx
 			unpacked_type unpacked;
 			uint nb_workers = g_cfg.video.renderer == video_renderer::vulkan ? utils::get_thread_count() : 1;
 
-			load_shaders(nb_workers, unpacked, directory_path, entries, entry_count, dlg);
+			load_shaders(nb_workers, unpacked, entry_count, dlg);
 
 			// Account for any invalid entries
 			entry_count = unpacked.size();
@@ -270,7 +417,7 @@ namespace rsx
 
 		void store(const pipeline_storage_type &pipeline, const RSXVertexProgram &vp, const RSXFragmentProgram &fp)
 		{
-			if (g_cfg.video.disable_on_disk_shader_cache)
+			if (g_cfg.video.disable_on_disk_shader_cache || !m_archive)
 			{
 				return;
 			}
@@ -283,68 +430,38 @@ namespace rsx
 
 			pipeline_data data = pack(pipeline, vp, fp);
 
-			std::string fp_name = root_path + "/raw/" + fmt::format("%llX.fp", data.fragment_program_hash);
-			std::string vp_name = root_path + "/raw/" + fmt::format("%llX.vp", data.vertex_program_hash);
-
-			// Writeback to cache either if file does not exist or it is invalid (unexpected size)
-			// Note: fs::write_file is not atomic, if the process is terminated in the middle an empty file is created
-			if (fs::stat_t s{}; !fs::stat(fp_name, s) || s.size != fp.ucode_length)
-			{
-				fs::write_file(fp_name, fs::rewrite, fp.get_data(), fp.ucode_length);
-			}
-
-			if (fs::stat_t s{}; !fs::stat(vp_name, s) || s.size != vp.data.size() * sizeof(u32))
-			{
-				fs::write_file(vp_name, fs::rewrite, vp.data);
-			}
-
-			u64 state_hash = 0;
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_ctrl);
-			state_hash ^= rpcs3::hash_base<u32>(data.vp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texture_dimensions);
-			state_hash ^= rpcs3::hash_base<u32>(data.fp_texcoord_control);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_unnormalized_coords);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_height);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_pixel_layout);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_lighting_flags);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_shadow_textures);
-			state_hash ^= rpcs3::hash_base<u16>(data.fp_redirected_textures);
-
-			const std::string pipeline_file_name = fmt::format("%llX+%llX+%llX+%llX.bin", data.vertex_program_hash, data.fragment_program_hash, data.pipeline_storage_hash, state_hash);
-			const std::string pipeline_path = root_path + "/pipelines/" + pipeline_class_name + "/" + version_prefix + "/" + pipeline_file_name;
-			fs::write_file(pipeline_path, fs::rewrite, &data, sizeof(data));
+			// Programs are deduplicated, pipelines are written after the programs they refer to
+			m_archive.append(record_type::fragment_program, data.fragment_program_hash, fp.get_data(), fp.ucode_length);
+			m_archive.append(record_type::vertex_program, data.vertex_program_hash, vp.data.data(), ::size32(vp.data) * sizeof(u32));
+			m_archive.append(record_type::pipeline, get_pipeline_key(data), &data, sizeof(data));
 		}
 
 		RSXVertexProgram load_vp_raw(u64 program_hash) const
 		{
 			RSXVertexProgram vp = {};
 
-			fs::file f(fmt::format("%s/raw/%llX.vp", root_path, program_hash));
-			if (f) f.read(vp.data, f.size() / sizeof(u32));
+			if (const auto blob = m_archive.find(record_type::vertex_program, program_hash))
+			{
+				vp.data.resize(blob->size / sizeof(u32));
+				std::memcpy(vp.data.data(), blob->data, vp.data.size() * sizeof(u32));
+			}
 
 			vp.skip_vertex_input_check = true;
 
 			return vp;
 		}
 
-		RSXFragmentProgram load_fp_raw(u64 program_hash)
+		RSXFragmentProgram load_fp_raw(u64 program_hash) const
 		{
-			fs::file f(fmt::format("%s/raw/%llX.fp", root_path, program_hash));
-
 			RSXFragmentProgram fp = {};
 
-			const u32 size = fp.ucode_length = f ? ::size32(f) : 0;
-
-			if (!size)
+			// The archive mapping outlives the loading process, so the data is not copied
+			if (const auto blob = m_archive.find(record_type::fragment_program, program_hash))
 			{
-				return fp;
+				fp.data = const_cast<u8*>(blob->data);
+				fp.ucode_length = blob->size;
 			}
 
-			auto buf = std::make_unique<u8[]>(size);
-			fp.data = buf.get();
-			f.read(buf.get(), size);
-			fragment_program_data[fragment_program_data.push_begin()] = std::move(buf);
 			return fp;
 		}
 
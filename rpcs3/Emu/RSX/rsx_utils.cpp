@@ -24,11 +24,219 @@ extern "C"
 #endif
 
 #include "util/sysinfo.hpp"
+#include "util/asm.hpp"
+#include "Utilities/Thread.h"
+
+#include <emmintrin.h>
 
 namespace rsx
 {
 	atomic_t<u64> g_rsx_shared_tag{ 0 };
 
+	namespace
+	{
+		// Scatter the low bits of value into the set bits of mask
+		u32 deposit_bits(u32 value, u32 mask)
+		{
+			u32 result = 0;
+
+			for (u32 bit = 1; mask && value; bit <<= 1)
+			{
+				if (mask & bit)
+				{
+					result |= (value & 1) ? bit : 0;
+					value >>= 1;
+					mask &= ~bit;
+				}
+			}
+
+			return result;
+		}
+
+		// Morton order inside a 4x4 tile: row j, texel pair h (x = 2h) is found at texel (h * 4) + (j & 1) * 2 + (j >> 1) * 8
+		template <u32 Size, bool Deswizzle>
+		void swizzle_tile_4x4(u8* linear, u32 pitch, u8* swizzled)
+		{
+			if constexpr (Size == 1)
+			{
+				if constexpr (!Deswizzle)
+				{
+					u32 r[4];
+
+					for (u32 j = 0; j < 4; ++j)
+					{
+						std::memcpy(&r[j], linear + j * pitch, 4);
+					}
+
+					const __m128i t01 = _mm_unpacklo_epi16(_mm_cvtsi32_si128(r[0]), _mm_cvtsi32_si128(r[1]));
+					const __m128i t23 = _mm_unpacklo_epi16(_mm_cvtsi32_si128(r[2]), _mm_cvtsi32_si128(r[3]));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(swizzled), _mm_unpacklo_epi64(t01, t23));
+				}
+				else
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(swizzled));
+					v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+					v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(3, 1, 2, 0));
+
+					for (u32 j = 0; j < 4; ++j, v = _mm_srli_si128(v, 4))
+					{
+						const u32 row = _mm_cvtsi128_si32(v);
+						std::memcpy(linear + j * pitch, &row, 4);
+					}
+				}
+			}
+			else if constexpr (Size == 2)
+			{
+				for (u32 j = 0; j < 4; j += 2)
+				{
+					u8* row0 = linear + j * pitch;
+					u8* row1 = row0 + pitch;
+					u8* tile = swizzled + j * 8;
+
+					if constexpr (!Deswizzle)
+					{
+						const __m128i r0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row0));
+						const __m128i r1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row1));
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(tile), _mm_unpacklo_epi32(r0, r1));
+					}
+					else
+					{
+						const __m128i v = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tile)), _MM_SHUFFLE(3, 1, 2, 0));
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(row0), v);
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(row1), _mm_unpackhi_epi64(v, v));
+					}
+				}
+			}
+			else if constexpr (Size == 4)
+			{
+				for (u32 j = 0; j < 4; j += 2)
+				{
+					const auto row0 = reinterpret_cast<__m128i*>(linear + j * pitch);
+					const auto row1 = reinterpret_cast<__m128i*>(linear + (j + 1) * pitch);
+					const auto tile = reinterpret_cast<__m128i*>(swizzled + j * 16);
+
+					if constexpr (!Deswizzle)
+					{
+						const __m128i r0 = _mm_loadu_si128(row0);
+						const __m128i r1 = _mm_loadu_si128(row1);
+						_mm_storeu_si128(tile, _mm_unpacklo_epi64(r0, r1));
+						_mm_storeu_si128(tile + 1, _mm_unpackhi_epi64(r0, r1));
+					}
+					else
+					{
+						const __m128i s0 = _mm_loadu_si128(tile);
+						const __m128i s1 = _mm_loadu_si128(tile + 1);
+						_mm_storeu_si128(row0, _mm_unpacklo_epi64(s0, s1));
+						_mm_storeu_si128(row1, _mm_unpackhi_epi64(s0, s1));
+					}
+				}
+			}
+			else
+			{
+				// 8 and 16 byte texels: every texel pair is already one or two full vectors
+				for (u32 j = 0; j < 4; ++j)
+				{
+					for (u32 h = 0; h < 2; ++h)
+					{
+						u8* pair = linear + j * pitch + h * (Size * 2);
+						u8* tile = swizzled + ((h * 4) + (j & 1) * 2 + (j >> 1) * 8) * Size;
+
+						if constexpr (!Deswizzle)
+						{
+							std::memcpy(tile, pair, Size * 2);
+						}
+						else
+						{
+							std::memcpy(pair, tile, Size * 2);
+						}
+					}
+				}
+			}
+		}
+
+		template <u32 Size, bool Deswizzle>
+		void swizzle_tile_rows(u8* linear, u8* swizzled, u32 width, u32 pitch, u32 tile_row_begin, u32 tile_row_end, u32 limit)
+		{
+			const u32 limit_mask = 1u << (limit << 1);
+
+			// Same carry scheme as convert_linear_swizzle, stepping 4 texels at a time
+			const u32 x_mask = (0x55555555 | ~(limit_mask - 1)) & ~15u;
+			const u32 y_mask = 0xAAAAAAAA & (limit_mask - 1);
+
+			for (u32 ty = tile_row_begin; ty < tile_row_end; ++ty)
+			{
+				const u32 y = ty * 4;
+				const u32 offs_y = deposit_bits(y, y_mask) + (y >> limit) * limit_mask;
+
+				u8* src = linear + y * pitch;
+				u32 offs_x = 0;
+
+				for (u32 x = 0; x < width; x += 4)
+				{
+					swizzle_tile_4x4<Size, Deswizzle>(src + x * Size, pitch, swizzled + (offs_y + offs_x) * Size);
+					offs_x = (offs_x - x_mask) & x_mask;
+				}
+			}
+		}
+	}
+
+	bool convert_linear_swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, u32 texel_size, bool input_is_swizzled)
+	{
+		if (!width || !height || (width | height) & 3)
+		{
+			return false;
+		}
+
+		decltype(&swizzle_tile_rows<1, false>) func = nullptr;
+
+		switch (texel_size)
+		{
+		case 1: func = input_is_swizzled ? &swizzle_tile_rows<1, true> : &swizzle_tile_rows<1, false>; break;
+		case 2: func = input_is_swizzled ? &swizzle_tile_rows<2, true> : &swizzle_tile_rows<2, false>; break;
+		case 4: func = input_is_swizzled ? &swizzle_tile_rows<4, true> : &swizzle_tile_rows<4, false>; break;
+		case 8: func = input_is_swizzled ? &swizzle_tile_rows<8, true> : &swizzle_tile_rows<8, false>; break;
+		case 16: func = input_is_swizzled ? &swizzle_tile_rows<16, true> : &swizzle_tile_rows<16, false>; break;
+		default: return false;
+		}
+
+		u8* linear = static_cast<u8*>(const_cast<void*>(input_is_swizzled ? output_pixels : input_pixels));
+		u8* swizzled = static_cast<u8*>(const_cast<void*>(input_is_swizzled ? input_pixels : output_pixels));
+
+		// Keep the row stride texel aligned like the scalar path
+		pitch -= pitch % texel_size;
+
+		const u32 limit = std::min(ceil_log2(width), ceil_log2(height));
+		const u32 tile_rows = height / 4;
+
+		// Large surfaces: split the tile rows between a few helper threads and the caller
+		const u64 size = u64{width} * height * texel_size;
+		const u32 thread_count = size >= 0x1000000 ? std::clamp<u32>(utils::get_thread_count() / 2, 1, 4) : 1;
+
+		if (thread_count == 1)
+		{
+			func(linear, swizzled, width, pitch, 0, tile_rows, limit);
+			return true;
+		}
+
+		const u32 rows_per_job = utils::aligned_div(tile_rows, thread_count);
+
+		atomic_t<u32> next_job = 0;
+
+		auto process = [&]()
+		{
+			for (u32 job; (job = next_job++) < thread_count;)
+			{
+				func(linear, swizzled, width, pitch, job * rows_per_job, std::min(tile_rows, (job + 1) * rows_per_job), limit);
+			}
+		};
+
+		named_thread_group workers("Swizzle Worker ", thread_count - 1, process);
+
+		process();
+		workers.join();
+		return true;
+	}
+
 	void convert_scale_image(u8 *dst, AVPixelFormat dst_format, int dst_width, int dst_height, int dst_pitch,
 		const u8 *src, AVPixelFormat src_format, int src_width, int src_height, int src_pitch, int src_slice_h, bool bilinear)
 	{
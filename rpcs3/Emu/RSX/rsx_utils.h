@@ -336,6 +336,12 @@ namespace rsx
 		return offset;
 	}
 
+	/**
+	 * Swizzle or deswizzle a 2D surface one 4x4 Morton tile at a time (SSE2 shuffles), large surfaces are split across threads.
+	 * Produces the same layout as convert_linear_swizzle, returns false if the surface is not made of whole tiles.
+	 */
+	bool convert_linear_swizzle_tiled(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch, u32 texel_size, bool input_is_swizzled);
+
 	/*   Note: What the ps3 calls swizzling in this case is actually z-ordering / morton ordering of pixels
 	*       - Input can be swizzled or linear, bool flag handles conversion to and from
 	*       - It will handle any width and height that are a power of 2, square or non square
@@ -345,6 +351,11 @@ namespace rsx
 	template <typename T, bool input_is_swizzled>
 	void convert_linear_swizzle(const void* input_pixels, void* output_pixels, u16 width, u16 height, u32 pitch)
 	{
+		if (convert_linear_swizzle_tiled(input_pixels, output_pixels, width, height, pitch, sizeof(T), input_is_swizzled))
+		{
+			return;
+		}
+
 		u32 log2width = ceil_log2(width);
 		u32 log2height = ceil_log2(height);
 
@@ -437,13 +448,31 @@ namespace rsx
 		const u32 log2_h = ceil_log2(height);
 		const u32 log2_d = ceil_log2(depth);
 
+		// Every coordinate owns a fixed set of bits in the index, so the per-axis parts can be precomputed and combined
+		std::vector<u32> x_offsets(width);
+		std::vector<u32> y_offsets(height);
+
+		for (u32 x = 0; x < width; ++x)
+		{
+			x_offsets[x] = calculate_z_index(x, 0, 0, log2_w, log2_h, log2_d);
+		}
+
+		for (u32 y = 0; y < height; ++y)
+		{
+			y_offsets[y] = calculate_z_index(0, y, 0, log2_w, log2_h, log2_d);
+		}
+
 		for (u32 z = 0; z < depth; ++z)
 		{
+			const u32 z_offset = calculate_z_index(0, 0, z, log2_w, log2_h, log2_d);
+
 			for (u32 y = 0; y < height; ++y)
 			{
+				const T* src_row = src + (z_offset | y_offsets[y]);
+
 				for (u32 x = 0; x < width; ++x)
 				{
-					*dst++ = src[calculate_z_index(x, y, z, log2_w, log2_h, log2_d)];
+					*dst++ = src_row[x_offsets[x]];
 				}
 			}
 		}
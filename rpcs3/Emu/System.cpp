@@ -7,9 +7,11 @@
 
 #include "Emu/Cell/ErrorCodes.h"
 #include "Emu/Cell/PPUThread.h"
+#include "Emu/Cell/PPUFunction.h"
 #include "Emu/Cell/PPUDisAsm.h"
 #include "Emu/Cell/PPUAnalyser.h"
 #include "Emu/Cell/SPUThread.h"
+#include "Emu/Cell/SPURecompiler.h"
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/lv2/sys_process.h"
 #include "Emu/Cell/lv2/sys_sync.h"
@@ -67,7 +69,7 @@ extern void ppu_precompile(std::vector<std::string>& dir_queue, std::vector<lv2_
 extern bool ppu_initialize(const ppu_module&, bool = false);
 extern void ppu_finalize(const ppu_module&);
 extern void ppu_unload_prx(const lv2_prx&);
-extern std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object&, const std::string&);
+extern std::shared_ptr<lv2_prx> ppu_load_prx(const ppu_prx_object&, const std::string&, std::function<void()>* = nullptr);
 extern std::pair<std::shared_ptr<lv2_overlay>, CellError> ppu_load_overlay(const ppu_exec_object&, const std::string& path);
 
 fs::file g_tty;
@@ -389,7 +391,12 @@ namespace
 
 				if (!skip_this_one && !native_dlg)
 				{
+					// May be null (headless)
 					dlg = Emu.GetCallbacks().get_msg_dialog();
+				}
+
+				if (dlg)
+				{
 					dlg->type.se_normal = true;
 					dlg->type.bg_invisible = true;
 					dlg->type.progress_bar_count = 1;
@@ -1268,6 +1275,12 @@ game_boot_result Emulator::Load(const std::string& title_id, bool add_only, bool
 
 				ppu_precompile(dir_queue, nullptr);
 
+				if (m_precompile_spu && !IsStopped())
+				{
+					// Build the SPU cache from the programs recorded by previous runs
+					spu_cache::initialize();
+				}
+
 				// Exit "process"
 				CallAfter([]
 				{
@@ -1849,6 +1862,21 @@ void Emulator::Run(bool start_playtime)
 		thr->state.notify_one(cpu_flag::stop);
 	}
 
+	if (g_cfg.core.perf_report && g_cfg.core.perf_report_dump_interval)
+	{
+		// Periodically write event stats for external monitoring
+		g_fxo->init<named_thread>("Perf Stats Dumper"sv, []()
+		{
+			const std::string path = fs::get_cache_dir() + "perf_stats.jsonl";
+
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				thread_ctrl::wait_for(g_cfg.core.perf_report_dump_interval * 1000);
+				perf_stat_base::dump(path);
+			}
+		});
+	}
+
 	if (g_cfg.misc.prevent_display_sleep)
 	{
 		disable_display_sleep();
@@ -2035,6 +2063,7 @@ void Emulator::Stop(bool restart)
 
 	jit_runtime::finalize();
 
+	ppu_call_stats::report();
 	perf_stat_base::report();
 
 	static u64 aw_refs = 0;
@@ -2139,6 +2168,16 @@ u32 Emulator::GetMaxThreads()
 	return thread_count;
 }
 
+u32 Emulator::GetLLVMCacheFlags()
+{
+	switch (g_cfg.core.llvm_cache_compression.get())
+	{
+	case llvm_cache_compression_type::fast: return 0x4;
+	case llvm_cache_compression_type::none: return 0x8;
+	default: return 0;
+	}
+}
+
 s32 error_code::error_report(const fmt_type_info* sup, u64 arg, const fmt_type_info* sup2, u64 arg2)
 {
 	static thread_local std::unordered_map<std::string, usz> g_tls_error_stats;
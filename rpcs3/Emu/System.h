@@ -104,6 +104,9 @@ class Emulator final
 
 	bool m_has_gui = true;
 
+	// Also build the SPU cache in the special boot mode (directory scan)
+	bool m_precompile_spu = false;
+
 public:
 	Emulator() = default;
 
@@ -258,6 +261,8 @@ public:
 	bool HasGui() const { return m_has_gui; }
 	void SetHasGui(bool has_gui) { m_has_gui = has_gui; }
 
+	void SetPrecompileSPU(bool precompile_spu) { m_precompile_spu = precompile_spu; }
+
 	void SetDefaultRenderer(video_renderer renderer) { m_default_renderer = renderer; }
 	void SetDefaultGraphicsAdapter(std::string adapter) { m_default_graphics_adapter = std::move(adapter); }
 	void SetConfigOverride(std::string path) { m_config_override_path = std::move(path); }
@@ -266,6 +271,9 @@ public:
 
 	static u32 GetMaxThreads();
 
+	// jit_compiler flags for the LLVM object cache compression setting
+	static u32 GetLLVMCacheFlags();
+
 	static void ConfigureLogs();
 	void ConfigurePPUCache() const;
 
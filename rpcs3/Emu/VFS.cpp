@@ -1,6 +1,7 @@
 #include "stdafx.h"
 #include "IdManager.h"
 #include "System.h"
+#include "system_config.h"
 #include "VFS.h"
 
 #include "Cell/lv2/sys_fs.h"
@@ -13,6 +14,9 @@
 #endif
 
 #include <thread>
+#include <unordered_map>
+
+LOG_CHANNEL(vfs_log, "VFS");
 
 struct vfs_directory
 {
@@ -29,6 +33,55 @@ struct vfs_manager
 
 	// VFS root
 	vfs_directory root{};
+
+	// Limit of entries in each cache (cleared when reached)
+	static constexpr usz cache_max = 8192;
+
+	struct path_entry
+	{
+		std::string local_path;
+		std::string out_path;
+	};
+
+	struct stat_entry
+	{
+		fs::stat_t info;
+		fs::error error;
+		u64 gen;
+	};
+
+	// Resolved paths, only depend on the mount table
+	shared_mutex path_mutex{};
+	std::unordered_map<std::string, path_entry> path_cache{};
+
+	// Host file information, invalidated by incrementing stat_gen
+	shared_mutex stat_mutex{};
+	std::unordered_map<std::string, stat_entry> stat_cache{};
+	atomic_t<u64> stat_gen{0};
+
+	atomic_t<u64> path_hits{0};
+	atomic_t<u64> path_misses{0};
+	atomic_t<u64> stat_hits{0};
+	atomic_t<u64> stat_misses{0};
+
+	vfs_manager() = default;
+
+	vfs_manager(const vfs_manager&) = delete;
+
+	vfs_manager& operator=(const vfs_manager&) = delete;
+
+	~vfs_manager()
+	{
+		const u64 path_total = path_hits + path_misses;
+		const u64 stat_total = stat_hits + stat_misses;
+
+		if (path_total || stat_total)
+		{
+			vfs_log.notice("Path cache: %u/%u hits (%.1f%%), stat cache: %u/%u hits (%.1f%%)",
+				path_hits, path_total, path_total ? 100. * path_hits / path_total : 0.,
+				stat_hits, stat_total, stat_total ? 100. * stat_hits / stat_total : 0.);
+		}
+	}
 };
 
 bool vfs::mount(std::string_view vpath, std::string_view path)
@@ -63,6 +116,11 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 		{
 			// Mounting completed
 			list.back()->path = path;
+
+			// Resolved paths may change
+			std::lock_guard path_lock(table.path_mutex);
+			table.path_cache.clear();
+			table.stat_gen++;
 			return true;
 		}
 
@@ -109,12 +167,8 @@ bool vfs::mount(std::string_view vpath, std::string_view path)
 	}
 }
 
-std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+static std::string vfs_get_uncached(const vfs_manager& table, std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
 {
-	auto& table = g_fxo->get<vfs_manager>();
-
-	reader_lock lock(table.mutex);
-
 	// Resulting path fragments: decoded ones
 	std::vector<std::string_view> result;
 	result.reserve(vpath.size() / 2);
@@ -281,6 +335,58 @@ std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir,
 	return std::string{result_base} + fmt::merge(escaped, "/");
 }
 
+std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
+{
+	auto& table = g_fxo->get<vfs_manager>();
+
+	reader_lock lock(table.mutex);
+
+	if (out_dir || !g_cfg.vfs.host_file_cache)
+	{
+		// Mounted subdirectories are not cached
+		return vfs_get_uncached(table, vpath, out_dir, out_path);
+	}
+
+	std::string key{vpath};
+
+	{
+		reader_lock path_lock(table.path_mutex);
+
+		if (const auto found = table.path_cache.find(key); found != table.path_cache.end())
+		{
+			table.path_hits++;
+
+			if (out_path)
+			{
+				*out_path = found->second.out_path;
+			}
+
+			return found->second.local_path;
+		}
+	}
+
+	table.path_misses++;
+
+	std::string processed;
+	std::string result = vfs_get_uncached(table, vpath, nullptr, &processed);
+
+	if (out_path)
+	{
+		*out_path = processed;
+	}
+
+	// Insert while the mount table is still locked
+	std::lock_guard path_lock(table.path_mutex);
+
+	if (table.path_cache.size() >= vfs_manager::cache_max)
+	{
+		table.path_cache.clear();
+	}
+
+	table.path_cache.emplace(std::move(key), vfs_manager::path_entry{result, std::move(processed)});
+	return result;
+}
+
 #if __cpp_char8_t >= 201811
 using char2 = char8_t;
 #else
@@ -727,6 +833,62 @@ std::string vfs::unescape(std::string_view name)
 	return result;
 }
 
+bool vfs::host::stat(const std::string& path, fs::stat_t& info)
+{
+	if (!g_cfg.vfs.host_file_cache)
+	{
+		return fs::stat(path, info);
+	}
+
+	auto& table = g_fxo->get<vfs_manager>();
+
+	// Must be read before the host file system is accessed
+	const u64 gen = table.stat_gen;
+
+	{
+		reader_lock lock(table.stat_mutex);
+
+		if (const auto found = table.stat_cache.find(path); found != table.stat_cache.end() && found->second.gen == gen)
+		{
+			table.stat_hits++;
+
+			if (found->second.error != fs::error::ok)
+			{
+				fs::g_tls_error = found->second.error;
+				return false;
+			}
+
+			info = found->second.info;
+			return true;
+		}
+	}
+
+	table.stat_misses++;
+
+	const bool result = fs::stat(path, info);
+	const fs::error error = result ? fs::error::ok : fs::g_tls_error;
+
+	if (result || error == fs::error::noent)
+	{
+		std::lock_guard lock(table.stat_mutex);
+
+		if (table.stat_cache.size() >= vfs_manager::cache_max)
+		{
+			table.stat_cache.clear();
+		}
+
+		table.stat_cache.insert_or_assign(path, vfs_manager::stat_entry{result ? info : fs::stat_t{}, error, gen});
+	}
+
+	fs::g_tls_error = error;
+	return result;
+}
+
+void vfs::host::invalidate()
+{
+	g_fxo->get<vfs_manager>().stat_gen++;
+}
+
 std::string vfs::host::hash_path(const std::string& path, const std::string& dev_root)
 {
 	return fmt::format(u8"%s/＄%s%s", dev_root, fmt::base57(std::hash<std::string>()(path)), fmt::base57(utils::get_unique_tsc()));
@@ -787,6 +949,8 @@ bool vfs::host::rename(const std::string& from, const std::string& to, const lv2
 
 	const auto fs_error = fs::g_tls_error;
 
+	vfs::host::invalidate();
+
 	idm::select<lv2_fs_object, lv2_file>([&](u32 /*id*/, lv2_file& file)
 	{
 		const auto escaped_real = Emu.GetCallbacks().resolve_path(file.real_path);
@@ -816,7 +980,7 @@ bool vfs::host::rename(const std::string& from, const std::string& to, const lv2
 	return res;
 }
 
-bool vfs::host::unlink(const std::string& path, [[maybe_unused]] const std::string& dev_root)
+static bool host_unlink(const std::string& path, [[maybe_unused]] const std::string& dev_root)
 {
 #ifdef _WIN32
 	if (auto device = fs::get_virtual_device(path))
@@ -826,7 +990,7 @@ bool vfs::host::unlink(const std::string& path, [[maybe_unused]] const std::stri
 	else
 	{
 		// Rename to special dummy name which will be ignored by VFS (but opened file handles can still read or write it)
-		const std::string dummy = hash_path(path, dev_root);
+		const std::string dummy = vfs::host::hash_path(path, dev_root);
 
 		if (!fs::rename(path, dummy, true))
 		{
@@ -850,20 +1014,27 @@ bool vfs::host::unlink(const std::string& path, [[maybe_unused]] const std::stri
 #endif
 }
 
-bool vfs::host::remove_all(const std::string& path, [[maybe_unused]] const std::string& dev_root, [[maybe_unused]] const lv2_fs_mount_point* mp, bool remove_root)
+bool vfs::host::unlink(const std::string& path, const std::string& dev_root)
+{
+	const bool result = host_unlink(path, dev_root);
+	invalidate();
+	return result;
+}
+
+static bool host_remove_all(const std::string& path, [[maybe_unused]] const std::string& dev_root, [[maybe_unused]] const lv2_fs_mount_point* mp, bool remove_root)
 {
 #ifdef _WIN32
 	if (remove_root)
 	{
 		// Rename to special dummy folder which will be ignored by VFS (but opened file handles can still read or write it)
-		const std::string dummy = hash_path(path, dev_root);
+		const std::string dummy = vfs::host::hash_path(path, dev_root);
 
 		if (!vfs::host::rename(path, dummy, mp, false))
 		{
 			return false;
 		}
 
-		if (!vfs::host::remove_all(dummy, dev_root, mp, false))
+		if (!host_remove_all(dummy, dev_root, mp, false))
 		{
 			return false;
 		}
@@ -891,14 +1062,14 @@ bool vfs::host::remove_all(const std::string& path, [[maybe_unused]] const std::
 
 			if (!entry.is_directory)
 			{
-				if (!vfs::host::unlink(path + '/' + entry.name, dev_root))
+				if (!host_unlink(path + '/' + entry.name, dev_root))
 				{
 					return false;
 				}
 			}
 			else
 			{
-				if (!vfs::host::remove_all(path + '/' + entry.name, dev_root, mp))
+				if (!host_remove_all(path + '/' + entry.name, dev_root, mp, true))
 				{
 					return false;
 				}
@@ -911,3 +1082,10 @@ bool vfs::host::remove_all(const std::string& path, [[maybe_unused]] const std::
 	return fs::remove_all(path, remove_root);
 #endif
 }
+
+bool vfs::host::remove_all(const std::string& path, const std::string& dev_root, const lv2_fs_mount_point* mp, bool remove_root)
+{
+	const bool result = host_remove_all(path, dev_root, mp, remove_root);
+	invalidate();
+	return result;
+}
@@ -6,6 +6,11 @@
 
 struct lv2_fs_mount_point;
 
+namespace fs
+{
+	struct stat_t;
+}
+
 namespace vfs
 {
 	// Mount VFS device
@@ -34,5 +39,11 @@ namespace vfs
 
 		// Delete folder contents using rename, done atomically if remove_root is true
 		bool remove_all(const std::string& path, const std::string& dev_root, const lv2_fs_mount_point* mp, bool remove_root = true);
+
+		// Call fs::stat, results (including missing files) are cached until the next invalidate() or mount
+		bool stat(const std::string& path, fs::stat_t& info);
+
+		// Drop cached stat results, must be called after modifying files without the functions above
+		void invalidate();
 	}
 }
@@ -3,6 +3,7 @@
 
 #include "util/sysinfo.hpp"
 #include "Utilities/Thread.h"
+#include "Utilities/File.h"
 
 #include <map>
 #include <mutex>
@@ -104,6 +105,9 @@ static std::map<std::string, perf_stat_base> s_perf_acc;
 
 static std::multimap<std::string, u64*> s_perf_sources;
 
+// Histograms at the beginning of the current query windows
+static std::map<std::string, std::array<u64, 66>> s_perf_window[static_cast<u32>(perf_stat_window::__count)];
+
 void perf_stat_base::add(u64 ns[66], const char* name) noexcept
 {
 	// Don't attempt to register some foreign/unnamed threads
@@ -158,5 +162,142 @@ void perf_stat_base::report() noexcept
 
 	s_perf_acc.clear();
 
+	for (auto& window : s_perf_window)
+	{
+		window.clear();
+	}
+
 	perf_log.notice("Performance report end.");
 }
+
+std::vector<perf_stat_summary> perf_stat_base::query(perf_stat_window window, bool reset_window) noexcept
+{
+	std::map<std::string, std::array<u64, 66>> totals;
+
+	auto& window_start = s_perf_window[static_cast<u32>(window)];
+
+	std::lock_guard lock(s_perf_mutex);
+
+	// Sum accumulated data and live TLS data without draining it (owners keep writing it without locking)
+	for (auto& [name, data] : s_perf_acc)
+	{
+		auto& total = totals[name];
+
+		for (u32 i = 0; i < 66; i++)
+		{
+			total[i] += data.m_log[i].load();
+		}
+	}
+
+	for (auto& [name, ns] : s_perf_sources)
+	{
+		auto& total = totals[name];
+
+		for (u32 i = 0; i < 66; i++)
+		{
+			total[i] += atomic_storage<u64>::load(ns[i]);
+		}
+	}
+
+	std::vector<perf_stat_summary> result;
+
+	for (auto& [name, total] : totals)
+	{
+		std::array<u64, 66> hist = total;
+
+		if (auto found = window_start.find(name); found != window_start.end())
+		{
+			for (u32 i = 0; i < 66; i++)
+			{
+				// Racy reads may be slightly behind the window start
+				hist[i] -= std::min(hist[i], found->second[i]);
+			}
+		}
+
+		if (reset_window)
+		{
+			window_start[name] = total;
+		}
+
+		// Bucket i (1..64) holds events of [2^(i-1), 2^i) ns
+		u64 count = 0;
+
+		for (u32 i = 1; i < 65; i++)
+		{
+			count += hist[i];
+		}
+
+		if (!count)
+		{
+			continue;
+		}
+
+		// Get the value at the specified rank, interpolating within the bucket
+		auto percentile = [&](f64 p) -> u64
+		{
+			const f64 rank = p * count;
+
+			u64 below = 0;
+
+			for (u32 i = 1; i < 65; i++)
+			{
+				if (hist[i] && below + hist[i] >= rank)
+				{
+					const f64 low = std::pow(2., i - 1);
+					return static_cast<u64>(low + low * (rank - below) / hist[i]);
+				}
+
+				below += hist[i];
+			}
+
+			return 0;
+		};
+
+		u32 last = 64;
+
+		while (!hist[last])
+		{
+			last--;
+		}
+
+		perf_stat_summary& out = result.emplace_back();
+		out.name = name;
+		out.count = count;
+		out.total = hist[65];
+		out.p50 = percentile(0.50);
+		out.p90 = percentile(0.90);
+		out.p99 = percentile(0.99);
+		out.max = ~u64{0} >> (64 - last);
+	}
+
+	std::sort(result.begin(), result.end(), [](const perf_stat_summary& a, const perf_stat_summary& b)
+	{
+		return a.total > b.total;
+	});
+
+	return result;
+}
+
+void perf_stat_base::dump(const std::string& path) noexcept
+{
+	const auto stats = query(perf_stat_window::dump, true);
+
+	if (stats.empty())
+	{
+		return;
+	}
+
+	const u64 stamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	std::string out;
+
+	for (const auto& stat : stats)
+	{
+		fmt::append(out, "{\"time_ms\":%u,\"name\":\"%s\",\"count\":%u,\"total_ns\":%u,\"p50_ns\":%u,\"p90_ns\":%u,\"p99_ns\":%u,\"max_ns\":%u}\n", stamp, stat.name, stat.count, stat.total, stat.p50, stat.p90, stat.p99, stat.max);
+	}
+
+	if (fs::file file{path, fs::write + fs::create + fs::append}; !file || file.write(out.data(), out.size()) != out.size())
+	{
+		perf_log.error("Failed to write performance stats to %s (%s)", path, fs::g_tls_error);
+	}
+}
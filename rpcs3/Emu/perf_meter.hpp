@@ -5,6 +5,8 @@
 #include "system_config.h"
 #include <array>
 #include <cmath>
+#include <vector>
+#include <string>
 
 LOG_CHANNEL(perf_log, "PERF");
 
@@ -32,6 +34,28 @@ inline const auto perf_name = []
 	return result;
 }();
 
+// Event length stats (in nanoseconds) estimated from the histogram
+struct perf_stat_summary
+{
+	std::string name;
+	u64 count;
+	u64 total;
+	u64 p50;
+	u64 p90;
+	u64 p99;
+	u64 max;
+};
+
+// Independent windows for stats queries
+enum class perf_stat_window : u32
+{
+	user,
+	dump,
+	overlay,
+
+	__count
+};
+
 class perf_stat_base
 {
 	atomic_t<u64> m_log[66]{};
@@ -63,6 +87,12 @@ public:
 
 	// Collect all data, report it, and clean
 	static void report() noexcept;
+
+	// Get stats of all events since the last reset of the window sorted by total time, optionally start a new window
+	static std::vector<perf_stat_summary> query(perf_stat_window window = perf_stat_window::user, bool reset_window = false) noexcept;
+
+	// Append stats of the current window to the file as JSON lines and start a new window
+	static void dump(const std::string& path) noexcept;
 };
 
 // Object that prints event length stats at the end
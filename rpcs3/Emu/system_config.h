@@ -27,6 +27,7 @@ struct cfg_root : cfg::node
 		cfg::_int<0, INT32_MAX> llvm_threads{ this, "Max LLVM Compile Threads", 0 };
 		cfg::_bool ppu_llvm_greedy_mode{ this, "PPU LLVM Greedy Mode", false, false };
 		cfg::_bool ppu_llvm_precompilation{ this, "PPU LLVM Precompilation", true };
+		cfg::_enum<llvm_cache_compression_type> llvm_cache_compression{ this, "LLVM Object Cache Compression", llvm_cache_compression_type::best };
 		cfg::_enum<thread_scheduler_mode> thread_scheduler{this, "Thread Scheduler Mode", thread_scheduler_mode::os};
 		cfg::_bool set_daz_and_ftz{ this, "Set DAZ and FTZ", false };
 		cfg::_enum<spu_decoder_type> spu_decoder{ this, "SPU Decoder", spu_decoder_type::llvm };
@@ -46,6 +47,8 @@ struct cfg_root : cfg::node
 		cfg::_bool spu_verification{ this, "SPU Verification", true }; // Should be enabled
 		cfg::_bool spu_cache{ this, "SPU Cache", true };
 		cfg::_bool spu_prof{ this, "SPU Profiler", false };
+		cfg::_bool ppu_prof{ this, "PPU Profiler", false };
+		cfg::_bool ppu_call_stats{ this, "PPU Call Stats", false }; // Record time spent in lv2 syscalls and HLE functions
 		cfg::_enum<tsx_usage> enable_TSX{ this, "Enable TSX", has_rtm() ? tsx_usage::enabled : tsx_usage::disabled }; // Enable TSX. Forcing this on Haswell/Broadwell CPUs should be used carefully
 		cfg::_bool spu_accurate_xfloat{ this, "Accurate xfloat", false };
 		cfg::_bool spu_approx_xfloat{ this, "Approximate xfloat", true };
@@ -55,6 +58,9 @@ struct cfg_root : cfg::node
 		cfg::_bool llvm_ppu_accurate_vector_nan{ this, "PPU LLVM Accurate Vector NaN values", false };
 		cfg::_int<-64, 64> stub_ppu_traps{ this, "Stub PPU Traps", 0, true }; // Hack, skip PPU traps for rare cases where the trap is continueable (specify relative instructions to skip)
 
+		cfg::_int<0, 16> vdec_threads{ this, "Video Decoder Threads", 0 }; // 0: Automatic, 1: Single-threaded cellVdec decoding
+		cfg::_bool vdec_frame_threading{ this, "Video Decoder Frame Threading", false }; // Decode several pictures at once (delays picture output), otherwise only slices are decoded in parallel
+
 		cfg::_bool debug_console_mode{ this, "Debug Console Mode", false }; // Debug console emulation, not recommended
 		cfg::_bool hook_functions{ this, "Hook static functions" };
 		cfg::set_entry libraries_control{ this, "Libraries Control" }; // Override HLE/LLE behaviour of selected libs
@@ -74,6 +80,7 @@ struct cfg_root : cfg::node
 
 		cfg::uint64 perf_report_threshold{this, "Performance Report Threshold", 500, true}; // In µs, 0.5ms = default, 0 = everything
 		cfg::_bool perf_report{this, "Enable Performance Report", false, true}; // Show certain perf-related logs
+		cfg::uint64 perf_report_dump_interval{this, "Performance Report Dump Interval", 0, true}; // In ms, 0 = disabled; periodically write event stats to perf_stats.jsonl
 	} core{ this };
 
 	struct node_vfs : cfg::node
@@ -97,6 +104,7 @@ struct cfg_root : cfg::node
 
 		cfg::_bool host_root{ this, "Enable /host_root/" };
 		cfg::_bool init_dirs{ this, "Initialize Directories", true };
+		cfg::_bool host_file_cache{ this, "Cache Host File Information", true }; // Cache resolved paths and host file attributes
 
 		cfg::_bool limit_cache_size{ this, "Limit disk cache size", false };
 		cfg::_int<0, 10240> cache_max_size{ this, "Disk cache maximum size (MB)", 5120 };
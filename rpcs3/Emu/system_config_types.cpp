@@ -255,6 +255,22 @@ void fmt_class_string<spu_decoder_type>::format(std::string& out, u64 arg)
 	});
 }
 
+template <>
+void fmt_class_string<llvm_cache_compression_type>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](llvm_cache_compression_type value)
+	{
+		switch (value)
+		{
+		case llvm_cache_compression_type::best: return "Best";
+		case llvm_cache_compression_type::fast: return "Fast";
+		case llvm_cache_compression_type::none: return "None";
+		}
+
+		return unknown;
+	});
+}
+
 template <>
 void fmt_class_string<spu_block_size_type>::format(std::string& out, u64 arg)
 {
@@ -15,6 +15,13 @@ enum class spu_decoder_type : unsigned
 	llvm,
 };
 
+enum class llvm_cache_compression_type
+{
+	best, // zlib (level 9)
+	fast, // zlib (level 1)
+	none, // Stored as is, memory-mapped on load
+};
+
 enum class spu_block_size_type
 {
 	safe,
@@ -241,6 +241,7 @@ constexpr auto arg_user_id    = "user-id";
 constexpr auto arg_installfw  = "installfw";
 constexpr auto arg_installpkg = "installpkg";
 constexpr auto arg_commit_db  = "get-commit-db";
+constexpr auto arg_build_caches = "build-caches";
 
 int find_arg(std::string arg, int& argc, char* argv[])
 {
@@ -253,7 +254,7 @@ int find_arg(std::string arg, int& argc, char* argv[])
 
 QCoreApplication* createApplication(int& argc, char* argv[])
 {
-	if (find_arg(arg_headless, argc, argv) != -1)
+	if (find_arg(arg_headless, argc, argv) != -1 || find_arg(arg_build_caches, argc, argv) != -1)
 		return new headless_application(argc, argv);
 
 #ifdef __linux__
@@ -436,8 +437,12 @@ int main(int argc, char** argv)
 			report_fatal_error(fmt::format("Not enough free space (%f KB)", stats.avail_free / 1000000.));
 		}
 
+		// Compression level of RPCS3.log.gz (1 = fastest, 9 = smallest)
+		bool level_ok = false;
+		const int compression_level = qEnvironmentVariableIntValue("RPCS3_LOG_COMPRESSION", &level_ok);
+
 		// Limit log size to ~25% of free space
-		log_file = logs::make_file_listener(fs::get_cache_dir() + "RPCS3.log", stats.avail_free / 4);
+		log_file = logs::make_file_listener(fs::get_cache_dir() + "RPCS3.log", stats.avail_free / 4, level_ok ? compression_level : 3);
 	}
 
 	static std::unique_ptr<logs::listener> fatal_listener = std::make_unique<fatal_error_listener>();
@@ -546,6 +551,7 @@ int main(int argc, char** argv)
 	parser.addOption(QCommandLineOption(arg_error, "For internal usage."));
 	parser.addOption(QCommandLineOption(arg_updating, "For internal usage."));
 	parser.addOption(QCommandLineOption(arg_commit_db, "Update commits.lst cache."));
+	parser.addOption(QCommandLineOption(arg_build_caches, "Build the PPU and SPU caches of the game directories passed as arguments, then exit (implies headless)."));
 	parser.process(app->arguments());
 
 	// Don't start up the full rpcs3 gui if we just want the version or help.
@@ -853,7 +859,66 @@ int main(int argc, char** argv)
 		sys_log.notice("Option passed via command line: %s %s", opt.toStdString(), parser.value(opt).toStdString());
 	}
 
-	if (const QStringList args = parser.positionalArguments(); !args.isEmpty() && !is_updating && !parser.isSet(arg_installfw) && !parser.isSet(arg_installpkg))
+	if (parser.isSet(arg_build_caches))
+	{
+		std::vector<std::string> dirs;
+
+		for (const QString& arg : parser.positionalArguments())
+		{
+			dirs.emplace_back(sstr(QFileInfo(arg).absoluteFilePath()));
+		}
+
+		if (dirs.empty())
+		{
+			report_fatal_error("No game directories passed for cache building!");
+		}
+
+		// Postpone to main event loop, titles are processed one after another
+		Emu.CallAfter([dirs = std::move(dirs)]()
+		{
+			extern atomic_t<u32> g_ppu_compiled_modules;
+			extern atomic_t<u32> g_spu_cache_built_programs;
+
+			const auto start = std::chrono::steady_clock::now();
+
+			u32 failed = 0;
+
+			Emu.SetPrecompileSPU(true);
+
+			for (const std::string& dir : dirs)
+			{
+				sys_log.notice("Building caches for %s", dir);
+
+				Emu.SetForceBoot(true);
+
+				if (const game_boot_result error = Emu.BootGame(dir, "", true); error != game_boot_result::no_errors)
+				{
+					sys_log.error("Building caches for '%s' failed: reason: %s", dir, error);
+					std::cerr << fmt::format("RPCS3: Building caches for '%s' failed: %s\n", dir, error);
+					failed++;
+					continue;
+				}
+
+				// The scan stops the emulator from the event loop once done
+				while (!Emu.IsStopped())
+				{
+					QCoreApplication::processEvents(QEventLoop::WaitForMoreEvents);
+				}
+			}
+
+			const double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count() / 1000.;
+
+			const std::string summary = fmt::format("Built caches for %u of %u title(s): %u PPU module(s), %u SPU program(s) compiled in %.3fs", ::size32(dirs) - failed, ::size32(dirs), +g_ppu_compiled_modules, +g_spu_cache_built_programs, elapsed);
+
+			sys_log.success("%s", summary);
+			std::cout << "RPCS3: " << summary << std::endl;
+
+			// Not Emu.Quit(), the exit code reports failed titles
+			Emu.CleanUp();
+			QCoreApplication::exit(failed ? 1 : 0);
+		});
+	}
+	else if (const QStringList args = parser.positionalArguments(); !args.isEmpty() && !is_updating && !parser.isSet(arg_installfw) && !parser.isSet(arg_installpkg))
 	{
 		sys_log.notice("Booting application from command line: %s", args.at(0).toStdString());
 
@@ -16,6 +16,7 @@
 #include "Emu/RSX/RSXDisAsm.h"
 #include "Emu/Cell/PPUDisAsm.h"
 #include "Emu/Cell/PPUThread.h"
+#include "Emu/Cell/PPUFunction.h"
 #include "Emu/Cell/SPUDisAsm.h"
 #include "Emu/Cell/SPUThread.h"
 #include "Emu/CPU/CPUThread.h"
@@ -27,6 +28,7 @@
 #include <QFontDatabase>
 #include <QCompleter>
 #include <QVBoxLayout>
+#include <QPlainTextEdit>
 #include <QTimer>
 #include <QCheckBox>
 #include <charconv>
@@ -281,6 +283,7 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 
 	const auto cpu = get_cpu();
 	const int row = m_debugger_list->currentRow();
+	const auto modifiers = QApplication::keyboardModifiers();
 
 	switch (event->key())
 	{
@@ -301,6 +304,7 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 			"\nKey N: Show next instruction the thread will execute after marked instruction, does nothing if target is not predictable."
 			"\nKey M: Show the Memory Viewer with initial address pointing to the marked instruction."
 			"\nKey I: Show RSX method detail."
+			"\nKey P: Show PPU syscall and HLE function call stats, call times require PPU Call Stats setting to be enabled."
 			"\nKey F10: Perform step-over on instructions. (skip function calls)"
 			"\nKey F11: Perform single-stepping on instructions."
 			"\nKey F1: Show this help dialog."
@@ -320,6 +324,30 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 		dlg->exec();
 		return;
 	}
+	case Qt::Key_P:
+	{
+		if (modifiers)
+		{
+			break;
+		}
+
+		QDialog* dlg = new QDialog(this);
+		dlg->setAttribute(Qt::WA_DeleteOnClose);
+		dlg->setWindowTitle(tr("PPU Call Stats"));
+
+		QPlainTextEdit* text = new QPlainTextEdit(dlg);
+		text->setReadOnly(true);
+		text->setLineWrapMode(QPlainTextEdit::NoWrap);
+		text->setFont(m_mono);
+		text->setPlainText(QString::fromStdString(ppu_call_stats::format(ppu_call_stats::query())));
+
+		QVBoxLayout* layout = new QVBoxLayout();
+		layout->addWidget(text);
+		dlg->setLayout(layout);
+		dlg->resize(900, 600);
+		dlg->show();
+		return;
+	}
 	default: break;
 	}
 
@@ -331,8 +359,6 @@ void debugger_frame::keyPressEvent(QKeyEvent* event)
 	const u32 address_limits = (cpu->id_type() == 2 ? 0x3fffc : ~3);
 	const u32 pc = (row >= 0 ? m_debugger_list->m_pc + row * 4 : cpu->get_pc()) & address_limits;
 
-	const auto modifiers = QApplication::keyboardModifiers();
-
 	if (modifiers & Qt::ControlModifier)
 	{
 		switch (event->key())
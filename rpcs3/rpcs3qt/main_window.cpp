@@ -712,8 +712,10 @@ void main_window::HandlePackageInstallation(QStringList file_paths)
 			}
 		}
 
+		const QString label_text = tr("Installing package (%0/%1), please wait...\n\n%2").arg(i + 1).arg(count).arg(app_info);
+
 		pdlg.SetValue(0);
-		pdlg.setLabelText(tr("Installing package (%0/%1), please wait...\n\n%2").arg(i + 1).arg(count).arg(app_info));
+		pdlg.setLabelText(label_text);
 		pdlg.show();
 
 		Emu.SetForceBoot(true);
@@ -737,6 +739,9 @@ void main_window::HandlePackageInstallation(QStringList file_paths)
 			return false;
 		});
 
+		const auto start_time = steady_clock::now();
+		auto last_rate_update = start_time;
+
 		// Wait for the completion
 		while (worker <= thread_state::aborting)
 		{
@@ -753,6 +758,18 @@ void main_window::HandlePackageInstallation(QStringList file_paths)
 			double pval = progress;
 			if (pval < 0.) pval += 1.;
 			pdlg.SetValue(static_cast<int>(pval * pdlg.maximum()));
+
+			// Show the estimated install speed twice per second
+			if (const auto now = steady_clock::now(); now - last_rate_update >= 500ms)
+			{
+				last_rate_update = now;
+
+				const double seconds = std::chrono::duration<double>(now - start_time).count();
+				const double rate = pval * file_info.size() / 1048576. / seconds;
+
+				pdlg.setLabelText(tr("%0\n\n%1 MB/s").arg(label_text).arg(rate, 0, 'f', 1));
+			}
+
 			QCoreApplication::processEvents();
 		}
 
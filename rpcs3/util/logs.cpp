@@ -81,24 +81,34 @@ namespace logs
 
 		alignas(128) atomic_t<u64> m_buf{0}; // MSB (40 bit): push begin, LSB (24 bis): push size
 		alignas(128) atomic_t<u64> m_out{0}; // Amount of bytes written to file
+		alignas(128) atomic_t<u64> m_dropped{0}; // Number of messages dropped since the last report
 
 		uchar m_zout[65536]{};
 
-		// Write buffered logs immediately
+		// Write buffered logs immediately (only called by the writer thread)
 		bool flush(u64 bufv);
 
+		// Write the number of dropped messages per channel (kept for the next attempt if the buffer is full or the channels are locked)
+		void report_dropped();
+
 	public:
-		file_writer(const std::string& name, u64 max_size);
+		file_writer(const std::string& name, u64 max_size, int compression_level);
 
 		virtual ~file_writer();
 
-		// Append raw data
-		void log(const char* text, usz size);
+		// Append raw data, returns false if it was dropped because the buffer is full (unless must_write is set)
+		bool log(const char* text, usz size, bool must_write = true);
+
+		// Count a dropped message
+		void drop()
+		{
+			m_dropped++;
+		}
 	};
 
 	struct file_listener final : file_writer, public listener
 	{
-		file_listener(const std::string& path, u64 max_size);
+		file_listener(const std::string& path, u64 max_size, int compression_level);
 
 		~file_listener() override = default;
 
@@ -380,7 +390,7 @@ void logs::message::broadcast(const char* fmt, const fmt_type_info* sup, ...) co
 	g_tls_log_control(fmt, -1);
 }
 
-logs::file_writer::file_writer(const std::string& name, u64 max_size)
+logs::file_writer::file_writer(const std::string& name, u64 max_size, int compression_level)
 	: m_max_size(max_size)
 {
 	if (!name.empty() && max_size)
@@ -401,7 +411,7 @@ logs::file_writer::file_writer(const std::string& name, u64 max_size)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wold-style-cast"
 #endif
-			if (deflateInit2(&m_zs, 9, Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+			if (deflateInit2(&m_zs, std::clamp(compression_level, 1, 9), Z_DEFLATED, 16 + 15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
 #ifndef _MSC_VER
 #pragma GCC diagnostic pop
 #endif
@@ -447,6 +457,11 @@ logs::file_writer::file_writer(const std::string& name, u64 max_size)
 					break;
 				}
 
+				if (m_dropped)
+				{
+					report_dropped();
+				}
+
 				std::this_thread::sleep_for(10ms);
 			}
 		}
@@ -461,7 +476,7 @@ logs::file_writer::~file_writer()
 	}
 
 	// Stop writer thread
-	while (m_out << 24 < m_buf)
+	while (m_out << 24 < m_buf || m_dropped)
 	{
 		std::this_thread::yield();
 	}
@@ -546,13 +561,53 @@ bool logs::file_writer::flush(u64 bufv)
 	return false;
 }
 
-void logs::file_writer::log(const char* text, usz size)
+void logs::file_writer::report_dropped()
 {
-	if (!m_fptr)
+	// Called by the writer thread: a producer may hold the channel registry while waiting for the buffer
+	if (!g_mutex.try_lock_shared())
 	{
 		return;
 	}
 
+	const u64 count = m_dropped;
+
+	std::vector<std::pair<channel*, u64>> counts;
+
+	std::string text = reinterpret_cast<const char*>(u8"·E ");
+	fmt::append(text, "LOG: %u messages dropped (writer too slow):", count);
+
+	for (auto&& [name, ch] : get_logger()->channels)
+	{
+		if (const u64 dropped = ch->dropped)
+		{
+			counts.emplace_back(ch, dropped);
+			fmt::append(text, " %s: %u;", name.empty() ? "(none)" : name.c_str(), dropped);
+		}
+	}
+
+	g_mutex.unlock_shared();
+
+	text.back() = '\n';
+
+	// Never wait for the buffer, the counters are kept for the next attempt instead
+	if (log(text.data(), text.size(), false))
+	{
+		m_dropped -= count;
+
+		for (auto&& [ch, dropped] : counts)
+		{
+			ch->dropped -= dropped;
+		}
+	}
+}
+
+bool logs::file_writer::log(const char* text, usz size, bool must_write)
+{
+	if (!m_fptr)
+	{
+		return true;
+	}
+
 	// TODO: write bigger fragment directly in blocking manner
 	while (size && size <= 0xffffff)
 	{
@@ -575,16 +630,14 @@ void logs::file_writer::log(const char* text, usz size)
 
 		if (!pos) [[unlikely]]
 		{
-			if ((bufv & 0xffffff) + size > 0xffffff || bufv & 0xffffff)
-			{
-				// Concurrency limit reached
-				std::this_thread::yield();
-			}
-			else
+			if ((bufv & 0xffffff) + size <= 0xffffff && !must_write)
 			{
-				// Queue is full, need to write out
-				flush(bufv);
+				// Queue is full, don't wait for the writer thread
+				return false;
 			}
+
+			// Concurrency limit reached or waiting for the writer thread
+			std::this_thread::yield();
 			continue;
 		}
 
@@ -602,10 +655,12 @@ void logs::file_writer::log(const char* text, usz size)
 		m_buf += (u64{size} << 24) - size;
 		break;
 	}
+
+	return true;
 }
 
-logs::file_listener::file_listener(const std::string& path, u64 max_size)
-	: file_writer(path, max_size)
+logs::file_listener::file_listener(const std::string& path, u64 max_size, int compression_level)
+	: file_writer(path, max_size, compression_level)
 	, listener()
 {
 	// Write UTF-8 BOM
@@ -663,12 +718,17 @@ void logs::file_listener::log(u64 stamp, const logs::message& msg, const std::st
 	text += _text;
 	text += '\n';
 
-	file_writer::log(text.data(), text.size());
+	// Errors are never dropped
+	if (!file_writer::log(text.data(), text.size(), msg.sev <= level::error || !msg.ch))
+	{
+		msg.ch->dropped++;
+		file_writer::drop();
+	}
 }
 
-std::unique_ptr<logs::listener> logs::make_file_listener(const std::string& path, u64 max_size)
+std::unique_ptr<logs::listener> logs::make_file_listener(const std::string& path, u64 max_size, int compression_level)
 {
-	std::unique_ptr<logs::listener> result = std::make_unique<logs::file_listener>(path, max_size);
+	std::unique_ptr<logs::listener> result = std::make_unique<logs::file_listener>(path, max_size, compression_level);
 
 	// Register file listener
 	result->add(result.get());
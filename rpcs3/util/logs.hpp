@@ -75,10 +75,14 @@ namespace logs
 		// The lowest logging level enabled for this channel (used for early filtering)
 		atomic_t<level> enabled;
 
+		// Number of messages dropped by the log file writer
+		atomic_t<u64> dropped;
+
 		// Initialize channel
 		constexpr channel(const char* name) noexcept
 			: name(name)
 			, enabled(level::notice)
+			, dropped(0)
 		{
 		}
 
@@ -148,8 +152,8 @@ namespace logs
 		return name;
 	}
 
-	// Called in main()
-	std::unique_ptr<logs::listener> make_file_listener(const std::string& path, u64 max_size);
+	// Called in main(), compression level is a zlib level for the .gz copy
+	std::unique_ptr<logs::listener> make_file_listener(const std::string& path, u64 max_size, int compression_level = 3);
 
 	// Called in main()
 	void set_init(std::initializer_list<stored_message>);